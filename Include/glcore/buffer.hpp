@@ -3,11 +3,44 @@
 
 #include <glcore/globj.hpp>
 #include <vector>
+#include <map>
 #include <utilities/data/vecs.hpp>
+#include <utilities/memory/memory.hpp>
 #include <gsl/span>
 
 namespace nitros::glcore
 {
+    namespace buffer
+    {
+        //Bytes written on the client keyed by their offset, overlapping and adjacent ranges are merged with the newer bytes on top
+        class GLCORE_EXPORT StagedRanges
+        {
+            public:
+            void add(std::size_t  offset, gsl::span<const std::uint8_t>  data);
+            //Drops the staged bytes in [offset, offset + size), splitting the ranges around it
+            void erase(std::size_t  offset, std::size_t  size);
+            void clear() noexcept;
+
+            [[nodiscard]] auto empty() const noexcept -> bool;
+            [[nodiscard]] auto ranges() const noexcept -> const std::map<std::size_t, std::vector<std::uint8_t>>&;
+
+            private:
+            std::map<std::size_t, std::vector<std::uint8_t>>    _ranges;
+        };
+
+        //IEEE 754 half precision bits, see vertex_format.hpp for conversion
+        struct half
+        {
+            std::uint16_t   bits;
+        };
+
+        //Signed w(2) z(10) y(10) x(10) from msb to lsb, written as std::array<packed_2_10_10_10, 1> for 4 components
+        struct packed_2_10_10_10
+        {
+            std::uint32_t   bits;
+        };
+    }
+
     class GLCORE_EXPORT Buffer : public GLobj
     {
         public:
@@ -19,10 +52,32 @@ namespace nitros::glcore
 
         enum class value_type
         {
-            FLOAT, UINT
+            FLOAT, UINT, INT, USHORT, SHORT, UBYTE, BYTE, HALF, INT_2_10_10_10
         };
 
-        explicit Buffer();
+        enum class usage
+        {
+            static_draw,    //Written once and drawn many times
+            dynamic_draw,   //Updated with sub data writes
+            stream_draw,    //Rewritten every frame, mappable for writing
+            read_back       //Written by the GPU and read by the client
+        };
+
+        /**
+         * immutable_store uses glNamedBufferStorage on OpenGL 4.5 and falls back to the usage hint elsewhere.
+         * Immutable static_draw and read_back Buffers can't be updated from the client, only by write_data.
+         * write_data with a different size recreates the immutable buffer object, rebind it afterwards.
+         * */
+        enum class storage_policy
+        {
+            mutable_store,
+            immutable_store
+        };
+
+        //While the ObjectPool is enabled, write_data of a mutable Buffer may swap in a pooled buffer object of the new size class
+        explicit Buffer(usage  usage_ = usage::static_draw, storage_policy  policy = storage_policy::mutable_store);
+        //Index Buffers of a VertexArray need the ELEMENT_BUFFER role, WebGL can't use a buffer object for both roles
+        explicit Buffer(buffer_type  type, usage  usage_ = usage::static_draw, storage_policy  policy = storage_policy::mutable_store);
         Buffer(const Buffer&) = delete;
         Buffer(Buffer&& ) = default;
         ~Buffer();
@@ -31,24 +86,127 @@ namespace nitros::glcore
 
         void bind(buffer_type type) const;
 
+        //normalized maps integer types to [0, 1] or [-1, 1] floats, else they are read as integers by the shader
         template <class type, std::size_t N>
-        void write_data(const std::vector<std::array<type, N>>  &data);
+        void write_data(const std::vector<std::array<type, N>>  &data, bool normalized = false);
+
+        //Interleaved vertices, the attributes are described by a vertex::Layout on the VertexArray
+        template <class Vertex>
+        void write_vertices(const std::vector<Vertex>  &vertices);
 
         template <class type, std::size_t N>
         void read_data(std::vector<std::array<type, N>>  &data) const;
 
+        //Offset in rows, the layout has to match the previous write_data
+        template <class type, std::size_t N>
+        void write_sub_data(std::size_t  offset, gsl::span<const std::array<type, N>>  data);
+
+        //Copies the rows on the client, the uploads are batched by flush_staged and the copies released after it
+        template <class type, std::size_t N>
+        void stage_sub_data(std::size_t  offset, gsl::span<const std::array<type, N>>  data);
+
+        //Uploads the merged staged ranges, call once per frame before drawing
+        void flush_staged();
+
+        //Byte offsets, copied on the GPU without a client round trip
+        void copy_from(const Buffer  &src, std::size_t  src_offset, std::size_t  dst_offset, std::size_t  size);
+
+        //Fills every row with value on the GPU, the layout has to match the previous write_data
+        template <class type, std::size_t N>
+        void clear(const std::array<type, N>  &value);
+
+        //Fills count rows from the row offset
+        template <class type, std::size_t N>
+        void clear(const std::array<type, N>  &value, std::size_t  offset, std::size_t  count);
+
+        [[nodiscard]] auto has_staged() const noexcept -> bool;
+
         [[nodiscard]] const std::size_t get_elements_count() const noexcept;
         [[nodiscard]] const std::size_t vec_length() const noexcept;
         [[nodiscard]] const std::size_t row_stride() const noexcept;
         [[nodiscard]] const value_type  get_value_type() const noexcept;
+        [[nodiscard]] auto is_normalized() const noexcept -> bool;
+        [[nodiscard]] auto is_integer_attribute() const noexcept -> bool;
+        [[nodiscard]] const std::size_t size_bytes() const noexcept;
+        [[nodiscard]] auto get_usage() const noexcept -> usage;
+        [[nodiscard]] auto is_immutable() const noexcept -> bool;
+        [[nodiscard]] auto get_buffer_type() const noexcept -> buffer_type;
 
         private:
         
-        void write_data(const gsl::span<const std::uint8_t>  data, bool is_integral);
-        void read_data(gsl::span<std::uint8_t>  vec, std::size_t stride, bool is_integral) const;
+        void write_data(const gsl::span<const std::uint8_t>  data);
+        void write_pooled(const gsl::span<const std::uint8_t>  data);
+        void read_data(gsl::span<std::uint8_t>  vec, std::size_t stride) const;
+        void write_sub_data(std::size_t  byte_offset, const gsl::span<const std::uint8_t>  data, std::size_t  stride);
+        void stage_sub_data(std::size_t  byte_offset, const gsl::span<const std::uint8_t>  data, std::size_t  stride);
+        void check_client_writable() const;
+        void clear_data(std::size_t  byte_offset, std::size_t  size, value_type  type, std::size_t  components, const gsl::span<const std::uint8_t>  value);
 
         std::size_t num_elements, vec_components, stride;
         value_type   _value_type;
+        bool         _normalized;
+        usage        _usage;
+        buffer_type  _type;
+        bool         _immutable;
+        std::size_t  _storage_size;
+
+        buffer::StagedRanges        _staged;
+    };
+
+    class Fence;
+
+    /**
+     * Streaming buffer for data rewritten every frame.
+     * The storage is split into one region per frame in flight and is mapped once, for the lifetime of the object.
+     * allocate() hands out sub ranges of the current frame region, next_frame() fences the region
+     * and waits for the GPU to release the region which gets reused next, throwing std::runtime_error if it isn't released within 10 seconds.
+     * 
+     * The offset of an Allocation is relative to the start of the buffer, use it directly as draw / bind offset.
+     * OpenGL 4.3 and ES have no persistent mapping, the allocations are written to a client copy
+     * and uploaded by flush(). Call flush() before drawing from the current frame allocations.
+     * */
+    class GLCORE_EXPORT StreamBuffer : public GLobj
+    {
+        public:
+        template <class type>
+        struct Allocation
+        {
+            std::size_t        offset;
+            gsl::span<type>    data;
+        };
+
+        explicit StreamBuffer(std::size_t  frame_size, std::uint32_t  frames_in_flight = 3);
+        StreamBuffer(const StreamBuffer&) = delete;
+        StreamBuffer(StreamBuffer&&) = delete;
+        ~StreamBuffer();
+
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+        StreamBuffer& operator=(StreamBuffer&&) = delete;
+
+        void bind(Buffer::buffer_type type) const;
+
+        //Returns an empty span when the frame region is exhausted
+        [[nodiscard]] auto allocate(std::size_t  size, std::size_t  alignment = 4) -> Allocation<std::uint8_t>;
+
+        template <class type, std::size_t N>
+        [[nodiscard]] auto allocate(std::size_t  count) -> Allocation<std::array<type, N>>;
+
+        void flush();
+        void next_frame();
+
+        [[nodiscard]] auto frame_size() const noexcept -> std::size_t;
+        [[nodiscard]] auto frame_offset() const noexcept -> std::size_t;
+        [[nodiscard]] auto frame_used() const noexcept -> std::size_t;
+
+        private:
+        std::size_t     _frame_size;
+        std::uint32_t   _frames;
+        std::uint32_t   _frame_index;
+        std::size_t     _head;
+        std::size_t     _flushed;
+        std::uint8_t*   _mapped_ptr;
+        std::vector<std::uint8_t>           _client_copy;
+        std::vector<utils::Uptr<Fence>>     _fences;
     };
 }
 
@@ -10,28 +10,62 @@ namespace nitros::glcore
         struct always_false : std::false_type {};
     }
     
+    namespace internal
+    {
+        template <class type>
+        constexpr auto to_value_type() -> Buffer::value_type
+        {
+            if constexpr( std::is_same_v<type, float> )
+                return Buffer::value_type::FLOAT;
+            else if constexpr( std::is_same_v<type, std::uint32_t> )
+                return Buffer::value_type::UINT;
+            else if constexpr( std::is_same_v<type, std::int32_t> )
+                return Buffer::value_type::INT;
+            else if constexpr( std::is_same_v<type, std::uint16_t> )
+                return Buffer::value_type::USHORT;
+            else if constexpr( std::is_same_v<type, std::int16_t> )
+                return Buffer::value_type::SHORT;
+            else if constexpr( std::is_same_v<type, std::uint8_t> )
+                return Buffer::value_type::UBYTE;
+            else if constexpr( std::is_same_v<type, std::int8_t> )
+                return Buffer::value_type::BYTE;
+            else if constexpr( std::is_same_v<type, buffer::half> )
+                return Buffer::value_type::HALF;
+            else if constexpr( std::is_same_v<type, buffer::packed_2_10_10_10> )
+                return Buffer::value_type::INT_2_10_10_10;
+            else
+                static_assert( always_false<type>{}, "Array Type not supported" );
+        }
+    }
+
     template <class type, std::size_t N>
-    void Buffer::write_data(const std::vector<std::array<type, N>>  &data)
+    void Buffer::write_data(const std::vector<std::array<type, N>>  &data, bool normalized)
     {
         static_assert(N > 0 && N <= 4);
-        vec_components = N;
-        num_elements = data.size() * N;
+        constexpr auto v_type = internal::to_value_type<type>();
+        constexpr auto is_packed = v_type == value_type::INT_2_10_10_10;
+        static_assert(!is_packed || N == 1, "Packed 2_10_10_10 holds 4 components in one element");
+
+        vec_components = is_packed ? 4 : N;
+        num_elements = data.size() * vec_components;
         stride = sizeof(std::array<type, N>);
-        bool is_integral = false;
-        
-        if constexpr( std::is_floating_point_v<type> && std::is_same_v<type, float> ) {
-            is_integral = false;
-            _value_type = value_type::FLOAT;
-        }
-        else if constexpr( std::is_integral_v<type> && std::is_unsigned_v<type> && std::is_same_v<type, std::uint32_t> ) {
-            is_integral = true;
-            _value_type = value_type::UINT;
-        }
-        else {
-            static_assert( internal::always_false<type>{}, "Array Type not supported" );
-        }
+        _value_type = v_type;
+        _normalized = std::is_integral_v<type> || is_packed ? normalized : false;
+
+        write_data( gsl::span<const std::uint8_t>{reinterpret_cast<const std::uint8_t*>(data.data()), gsl::narrow_cast<std::ptrdiff_t>(data.size() * stride) } );
+    }
 
-        write_data( gsl::span<const std::uint8_t>{reinterpret_cast<const std::uint8_t*>(data.data()), gsl::narrow_cast<std::ptrdiff_t>(data.size() * stride) } , is_integral );    
+    template <class Vertex>
+    void Buffer::write_vertices(const std::vector<Vertex>  &vertices)
+    {
+        static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex must be trivially copyable");
+        vec_components = 1;
+        num_elements = vertices.size();
+        stride = sizeof(Vertex);
+        _value_type = value_type::FLOAT;
+        _normalized = false;
+
+        write_data( gsl::span<const std::uint8_t>{reinterpret_cast<const std::uint8_t*>(vertices.data()), gsl::narrow_cast<std::ptrdiff_t>(vertices.size() * stride) } );
     }
 
     template <class type, std::size_t N>
@@ -39,20 +73,55 @@ namespace nitros::glcore
     {
         static_assert(N > 0 && N <= 4);
         constexpr auto stride = sizeof(std::array<type, N>);
-        data.resize(num_elements/vec_components);
+        static_assert( sizeof(internal::to_value_type<type>()) > 0 );
+        data.resize(size_bytes() / stride);
 
-        bool is_integral = false;
-        if constexpr( std::is_floating_point_v<type> ) {
-            is_integral = false;
-        }
-        else if constexpr( std::is_integral_v<type> && std::is_unsigned_v<type>) {
-            is_integral = true;
-        }
-        else {
-            static_assert( internal::always_false<type>{}, "Array Type not supported" );
+        auto data_span = gsl::span<std::uint8_t>{reinterpret_cast<std::uint8_t*>(data.data()), gsl::narrow_cast<std::ptrdiff_t>( data.size() * stride ) };
+        read_data( data_span, stride );
+    }
+
+    template <class type, std::size_t N>
+    void Buffer::write_sub_data(std::size_t  offset, gsl::span<const std::array<type, N>>  data)
+    {
+        static_assert(N > 0 && N <= 4);
+        constexpr auto stride = sizeof(std::array<type, N>);
+        write_sub_data( offset * stride, gsl::span<const std::uint8_t>{reinterpret_cast<const std::uint8_t*>(data.data()), gsl::narrow_cast<std::ptrdiff_t>(data.size_bytes()) }, stride );
+    }
+
+    template <class type, std::size_t N>
+    void Buffer::stage_sub_data(std::size_t  offset, gsl::span<const std::array<type, N>>  data)
+    {
+        static_assert(N > 0 && N <= 4);
+        constexpr auto stride = sizeof(std::array<type, N>);
+        stage_sub_data( offset * stride, gsl::span<const std::uint8_t>{reinterpret_cast<const std::uint8_t*>(data.data()), gsl::narrow_cast<std::ptrdiff_t>(data.size_bytes()) }, stride );
+    }
+
+    template <class type, std::size_t N>
+    void Buffer::clear(const std::array<type, N>  &value)
+    {
+        clear(value, 0, size_bytes() / sizeof(std::array<type, N>));
+    }
+
+    template <class type, std::size_t N>
+    void Buffer::clear(const std::array<type, N>  &value, std::size_t  offset, std::size_t  count)
+    {
+        static_assert(N > 0 && N <= 4);
+        constexpr auto stride = sizeof(std::array<type, N>);
+        constexpr auto v_type = internal::to_value_type<type>();
+        if(stride != this->stride || v_type != _value_type){
+            throw std::runtime_error("Write Layout and Clear Layout doesn't match");
         }
+        clear_data( offset * stride, count * stride, v_type, N, gsl::span<const std::uint8_t>{reinterpret_cast<const std::uint8_t*>(value.data()), gsl::narrow_cast<std::ptrdiff_t>(stride) } );
+    }
+
+    template <class type, std::size_t N>
+    auto StreamBuffer::allocate(std::size_t  count) -> Allocation<std::array<type, N>>
+    {
+        static_assert(N > 0 && N <= 4);
+        constexpr auto stride = sizeof(std::array<type, N>);
 
-        auto data_span = gsl::span<std::uint8_t>{reinterpret_cast<std::uint8_t*>(data.data()), gsl::narrow_cast<std::ptrdiff_t>( num_elements * sizeof(type) ) };
-        read_data( data_span, stride , is_integral );
+        auto [offset, bytes] = allocate(count * stride, stride);
+        auto data = gsl::span<std::array<type, N>>{ reinterpret_cast<std::array<type, N>*>(bytes.data()), gsl::narrow_cast<std::ptrdiff_t>( bytes.size_bytes() / stride ) };
+        return { offset, data };
     }
 } // namespace nitros::glcore
@@ -0,0 +1,114 @@
+
+
+#ifndef GLCORE_BUFFER_HEAP_HPP
+#define GLCORE_BUFFER_HEAP_HPP
+
+#include "glcore/globj.hpp"
+#include "glcore/buffer.hpp"
+#include <gsl/gsl>
+#include <map>
+#include <unordered_map>
+#include <optional>
+
+namespace nitros::glcore
+{
+    /**
+     * One large buffer object shared by many meshes.
+     * Vertex and index ranges are sub allocated from a first fit free list, neighbouring free blocks are merged on free.
+     * Handles stay valid across defragment(), query the current range with get_range after defragmenting.
+     * 
+     * Typed allocations are aligned to the row stride, their offset / stride is usable as base vertex or first index.
+     * */
+    class GLCORE_EXPORT BufferHeap : public GLobj
+    {
+        public:
+        struct Handle
+        {
+            std::uint32_t   key;
+        };
+
+        struct Range
+        {
+            std::size_t     offset;
+            std::size_t     size;
+        };
+
+        explicit BufferHeap(std::size_t  capacity);
+        BufferHeap(const BufferHeap &) = delete;
+        BufferHeap(BufferHeap &&) = delete;
+        ~BufferHeap();
+
+        BufferHeap& operator=(const BufferHeap &) = delete;
+        BufferHeap& operator=(BufferHeap &&) = delete;
+
+        void bind(Buffer::buffer_type type) const;
+
+        //Returns empty if no free block is large enough
+        [[nodiscard]] auto allocate(std::size_t  size, std::size_t  alignment = 4) -> std::optional<Handle>;
+
+        template <class type, std::size_t N>
+        [[nodiscard]] auto allocate(std::size_t  count) -> std::optional<Handle>;
+
+        void free(const Handle  &handle);
+
+        void write(const Handle  &handle, const gsl::span<const std::uint8_t>  data, std::size_t  offset = 0);
+
+        template <class type, std::size_t N>
+        void write(const Handle  &handle, const std::vector<std::array<type, N>>  &data);
+
+        [[nodiscard]] auto get_range(const Handle  &handle) const -> Range;
+
+        //Offset of the handle in rows of std::array<type, N>
+        template <class type, std::size_t N>
+        [[nodiscard]] auto first_element(const Handle  &handle) const -> std::size_t;
+
+        //Moves the live allocations to the front of the heap with GPU copies, returns the number of moved allocations
+        auto defragment() -> std::size_t;
+
+        [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+        [[nodiscard]] auto used() const noexcept -> std::size_t;
+        [[nodiscard]] auto largest_free_block() const noexcept -> std::size_t;
+
+        private:
+        struct Block
+        {
+            std::size_t     offset;
+            std::size_t     size;
+            std::size_t     alignment;
+        };
+
+        void release(std::size_t  offset, std::size_t  size);
+        void copy(std::size_t  src_offset, std::size_t  dst_offset, std::size_t  size, std::uint32_t  scratch);
+
+        std::size_t     _capacity;
+        std::size_t     _used;
+        std::uint32_t   _next_key;
+        std::map<std::size_t, std::size_t>              _free_blocks;
+        std::unordered_map<std::uint32_t, Block>        _blocks;
+    };
+
+    template <class type, std::size_t N>
+    auto BufferHeap::allocate(std::size_t  count) -> std::optional<Handle>
+    {
+        static_assert(N > 0 && N <= 4);
+        constexpr auto stride = sizeof(std::array<type, N>);
+        return allocate(count * stride, stride);
+    }
+
+    template <class type, std::size_t N>
+    void BufferHeap::write(const Handle  &handle, const std::vector<std::array<type, N>>  &data)
+    {
+        static_assert(N > 0 && N <= 4);
+        constexpr auto stride = sizeof(std::array<type, N>);
+        write( handle, gsl::span<const std::uint8_t>{reinterpret_cast<const std::uint8_t*>(data.data()), gsl::narrow_cast<std::ptrdiff_t>(data.size() * stride) } );
+    }
+
+    template <class type, std::size_t N>
+    auto BufferHeap::first_element(const Handle  &handle) const -> std::size_t
+    {
+        return get_range(handle).offset / sizeof(std::array<type, N>);
+    }
+} // namespace nitros::glcore
+
+
+#endif
@@ -0,0 +1,77 @@
+
+
+#ifndef GLCORE_COMMAND_LIST_HPP
+#define GLCORE_COMMAND_LIST_HPP
+
+#include "glcore/glcore_export.h"
+#include "glcore/render_queue.hpp"
+#include "glcore/rasterizer.hpp"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace nitros::glcore
+{
+    /**
+     * Records glcore commands without touching GL, to be executed later on the context thread.
+     * Build one CommandList per worker thread, a CommandList itself isn't thread safe.
+     * Commands are packed into one growing byte arena, reset() keeps the allocation for the next frame.
+     *
+     * Objects are recorded by pointer and must outlive execute(). Uniforms apply to the Shader of the last
+     * use_shader of the same list, set them after use_shader like on the GL thread.
+     * */
+    class GLCORE_EXPORT CommandList
+    {
+        public:
+        CommandList() = default;
+        explicit CommandList(std::size_t  reserve_bytes);
+
+        //A null framebuffer binds the default FrameBuffer
+        void bind_framebuffer(const FrameBuffer*  framebuffer);
+        void clear_color(FrameBuffer  &framebuffer, const utils::vec4f  &color);
+        void clear_depth(FrameBuffer  &framebuffer, float  depth = 1.f);
+
+        void use_shader(Shader  &shader);
+        void set_uniform(const std::string  &name, const std::array<float, 1>  &value);
+        void set_uniform(const std::string  &name, const std::array<float, 2>  &value);
+        void set_uniform(const std::string  &name, const std::array<float, 3>  &value);
+        void set_uniform(const std::string  &name, const std::array<float, 4>  &value);
+        void set_uniform(const std::string  &name, const std::array<std::int32_t, 1>  &value);
+        void set_uniform(const std::string  &name, const std::array<std::int32_t, 2>  &value);
+        void set_uniform(const std::string  &name, const std::array<std::int32_t, 3>  &value);
+        void set_uniform(const std::string  &name, const std::array<std::int32_t, 4>  &value);
+        void set_uniform_matrix4fv(const std::string  &name, const glm::mat4  &mat, bool transpose = false);
+
+        void bind_texture(const render::TextureBinding  &binding);
+        void set_capability(Rasterizer::capability  type, bool enable);
+
+        void draw(const VertexArray  &vertex_array, std::uint32_t  instance_count = 1);
+        void draw_index_count(const VertexArray  &vertex_array, std::uint32_t  index_offset, std::uint32_t  index_count);
+        void draw_range(const VertexArray  &vertex_array, const vertex::MeshRange  &range, std::uint32_t  instance_count = 1, std::uint32_t  base_instance = 0);
+
+        //Appends the commands of other, the lists of several workers can be merged in order
+        void append(const CommandList  &other);
+
+        //Replays the commands in record order, call on the GL thread only
+        void execute() const;
+        void reset() noexcept;
+
+        [[nodiscard]] auto command_count() const noexcept -> std::size_t;
+        [[nodiscard]] auto size_bytes() const noexcept -> std::size_t;
+        [[nodiscard]] auto empty() const noexcept -> bool;
+
+        private:
+        template <class payload_type>
+        void record(std::uint8_t  code, const payload_type  &payload, const std::string  &name = {});
+
+        template <class type, std::size_t N>
+        void record_uniform(const std::string  &name, const std::array<type, N>  &value);
+
+        std::vector<std::uint8_t>   _arena;
+        std::size_t                 _commands = 0;
+        bool                        _has_shader = false;
+    };
+}
+
+#endif
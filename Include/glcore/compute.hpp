@@ -0,0 +1,131 @@
+
+
+#ifndef GLCORE_COMPUTE_HPP
+#define GLCORE_COMPUTE_HPP
+
+#include "glcore/glcore_export.h"
+#include "glcore/shader.h"
+#include "glcore/buffer.hpp"
+#include "glcore/textures.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace nitros::glcore
+{
+    namespace compute
+    {
+        //Number of work groups in each dimension
+        struct WorkGroups
+        {
+            std::uint32_t   x;
+            std::uint32_t   y = 1;
+            std::uint32_t   z = 1;
+        };
+
+        //Layout of DispatchIndirectCommand, written as std::array<std::uint32_t, 3> rows into a Buffer
+        struct DispatchIndirectCommand
+        {
+            std::uint32_t   num_groups_x;
+            std::uint32_t   num_groups_y;
+            std::uint32_t   num_groups_z;
+        };
+
+        static_assert(sizeof(DispatchIndirectCommand) == 3 * sizeof(std::uint32_t));
+
+        //layout(binding = index) of a buffer block
+        struct StorageBinding
+        {
+            std::uint32_t   index;
+        };
+
+        //layout(binding = index) of an image uniform
+        struct ImageUnit
+        {
+            std::uint32_t   index;
+        };
+
+        enum class access
+        {
+            read_only, write_only, read_write
+        };
+
+        //Has to match the format layout qualifier of the image uniform
+        enum class image_format
+        {
+            r32f, rg32f, rgba32f, rgba16f, rgba8,
+            r32i, r32ui, rgba32i, rgba32ui
+        };
+
+        //Which later reads have to see the writes of a dispatch
+        enum class barrier : std::uint32_t {
+            NONE                = 0,
+            SHADER_STORAGE      = 1u << 0,  //Buffer blocks of later shaders
+            SHADER_IMAGE_ACCESS = 1u << 1,  //Image load / store of later shaders
+            TEXTURE_FETCH       = 1u << 2,  //Sampling the written images
+            VERTEX_ATTRIB       = 1u << 3,  //Written Buffers used as vertex attributes
+            ELEMENT_ARRAY       = 1u << 4,  //Written Buffers used as index Buffers
+            COMMAND             = 1u << 5,  //Written Buffers used for indirect draws and dispatches
+            BUFFER_UPDATE       = 1u << 6,  //Client reads and writes of the written Buffers
+            FRAMEBUFFER         = 1u << 7,
+            ALL                 = 0xFFu
+        };
+
+        constexpr auto operator|(barrier lhs, barrier rhs) -> barrier {
+            return static_cast<barrier>( static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs) );
+        }
+
+        constexpr auto has_flag(barrier set, barrier flag) -> bool {
+            return ( static_cast<std::uint32_t>(set) & static_cast<std::uint32_t>(flag) ) != 0;
+        }
+    }
+
+    /**
+     * Compute shader program, needs OpenGL 4.3. The constructor throws std::runtime_error on OpenGL ES 3.0.
+     * Dispatches use the program, bindings are global GL state and stay bound for later dispatches and draws.
+     * Writes of a dispatch are only visible to later commands after a memory_barrier naming them.
+     * */
+    class GLCORE_EXPORT ComputeProgram
+    {
+        public:
+        explicit ComputeProgram(const std::string  &compute_pgm);
+        ComputeProgram(const ComputeProgram&) = delete;
+        ComputeProgram(ComputeProgram &&) = default;
+        ~ComputeProgram() = default;
+
+        ComputeProgram& operator=(const ComputeProgram&) = delete;
+        ComputeProgram& operator=(ComputeProgram&&) = default;
+
+        void use() const;
+
+        void dispatch(const compute::WorkGroups  &groups) const;
+
+        //Enough work groups to cover count invocations in each dimension
+        void dispatch_invocations(const compute::WorkGroups  &count) const;
+
+        //offset in bytes of a DispatchIndirectCommand in buffer
+        void dispatch_indirect(const Buffer  &buffer, std::size_t  offset = 0) const;
+
+        static void bind_storage(compute::StorageBinding  binding, const Buffer  &buffer);
+
+        //Byte range, offset has to be a multiple of GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT
+        static void bind_storage(compute::StorageBinding  binding, const Buffer  &buffer, std::size_t  offset, std::size_t  size);
+
+        //Binds all faces of a cube map unless a layer is given
+        static void bind_image(compute::ImageUnit  unit, const ColorTexture  &texture, std::uint32_t  level, compute::access  access,
+                               compute::image_format  format, std::optional<std::uint32_t>  layer = std::nullopt);
+
+        static void memory_barrier(compute::barrier  barriers);
+
+        [[nodiscard]] auto work_group_size() const noexcept -> const std::array<std::uint32_t, 3>&;
+        [[nodiscard]] auto get_shader() noexcept -> Shader&;
+        [[nodiscard]] auto get_program() const -> std::uint32_t;
+
+        private:
+        Shader                          _shader;
+        std::array<std::uint32_t, 3>    _work_group_size;
+    };
+}
+
+#endif
@@ -0,0 +1,96 @@
+
+
+#ifndef GLCORE_INDIRECT_BUFFER_HPP
+#define GLCORE_INDIRECT_BUFFER_HPP
+
+#include "glcore/globj.hpp"
+#include <gsl/gsl>
+#include <vector>
+#include <cstdint>
+
+namespace nitros::glcore
+{
+    namespace indirect
+    {
+        //Layout of DrawElementsIndirectCommand, first_index in indices of the index buffer
+        struct DrawElementsCommand
+        {
+            std::uint32_t   count;
+            std::uint32_t   instance_count;
+            std::uint32_t   first_index;
+            std::int32_t    base_vertex;
+            std::uint32_t   base_instance;
+        };
+
+        //Layout of DrawArraysIndirectCommand
+        struct DrawArraysCommand
+        {
+            std::uint32_t   count;
+            std::uint32_t   instance_count;
+            std::uint32_t   first;
+            std::uint32_t   base_instance;
+        };
+
+        static_assert(sizeof(DrawElementsCommand) == 5 * sizeof(std::uint32_t));
+        static_assert(sizeof(DrawArraysCommand) == 4 * sizeof(std::uint32_t));
+    }
+
+    /**
+     * Draw commands of one type recorded on the client and uploaded to a GL_DRAW_INDIRECT_BUFFER.
+     * Submit with VertexArray::draw_indirect, all commands go out in a single glMultiDraw*Indirect call on OpenGL 4.3.
+     * The commands are uploaded on the first bind after a change, the buffer grows and never shrinks.
+     *
+     * OpenGL ES 3.0 has no indirect draws, VertexArray::draw_indirect issues the commands one by one from the client copy.
+     * */
+    class GLCORE_EXPORT IndirectCommandBuffer : public GLobj
+    {
+        public:
+        enum class command_type
+        {
+            arrays,
+            elements
+        };
+
+        explicit IndirectCommandBuffer(command_type  type = command_type::elements);
+        IndirectCommandBuffer(const IndirectCommandBuffer &) = delete;
+        IndirectCommandBuffer(IndirectCommandBuffer &&) = delete;
+        ~IndirectCommandBuffer();
+
+        IndirectCommandBuffer& operator=(const IndirectCommandBuffer &) = delete;
+        IndirectCommandBuffer& operator=(IndirectCommandBuffer &&) = delete;
+
+        //Throws std::invalid_argument if the command doesn't match the command_type
+        void add(const indirect::DrawElementsCommand  &command);
+        void add(const indirect::DrawArraysCommand  &command);
+
+        //Replaces the command at index
+        void set(std::size_t  index, const indirect::DrawElementsCommand  &command);
+        void set(std::size_t  index, const indirect::DrawArraysCommand  &command);
+
+        void clear() noexcept;
+        void reserve(std::size_t  count);
+
+        //Uploads pending changes and binds GL_DRAW_INDIRECT_BUFFER
+        void bind() const;
+
+        [[nodiscard]] auto get_command_type() const noexcept -> command_type;
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+        [[nodiscard]] auto empty() const noexcept -> bool;
+        [[nodiscard]] auto command_stride() const noexcept -> std::size_t;
+
+        [[nodiscard]] auto elements_commands() const -> gsl::span<const indirect::DrawElementsCommand>;
+        [[nodiscard]] auto arrays_commands() const -> gsl::span<const indirect::DrawArraysCommand>;
+
+        private:
+        void upload() const;
+
+        command_type    _type;
+        std::vector<indirect::DrawElementsCommand>  _elements;
+        std::vector<indirect::DrawArraysCommand>    _arrays;
+
+        mutable std::size_t     _capacity;
+        mutable bool            _dirty;
+    };
+}
+
+#endif
@@ -0,0 +1,74 @@
+
+
+#ifndef GLCORE_LOD_HPP
+#define GLCORE_LOD_HPP
+
+#include "glcore/glcore_export.h"
+#include "glcore/buffer.hpp"
+#include "glcore/vertexarray.hpp"
+#include <gsl/gsl>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace nitros::glcore
+{
+    namespace lod
+    {
+        //Offset and count in indices of one level in the index Buffer, error in position units
+        struct Level
+        {
+            std::uint32_t   index_offset;
+            std::uint32_t   index_count;
+            float           error;
+        };
+    }
+
+    /**
+     * Chain of simplified index lists of one mesh sharing its vertices, level 0 is the full mesh.
+     * Every level is cache optimized and stored one after another, write_to uploads all levels into one index Buffer.
+     * Levels stop when a simplification can't reach reduction times the previous index count.
+     * */
+    class GLCORE_EXPORT LodChain
+    {
+        public:
+        LodChain(gsl::span<const std::uint32_t>  indices, gsl::span<const float>  positions, std::size_t  position_stride = 3,
+                 std::size_t  max_levels = 4, float  reduction = 0.5f);
+
+        //index_buffer needs the ELEMENT_BUFFER role
+        void write_to(Buffer  &index_buffer) const;
+
+        [[nodiscard]] auto levels() const noexcept -> const std::vector<lod::Level>&;
+        [[nodiscard]] auto indices() const noexcept -> const std::vector<std::uint32_t>&;
+
+        private:
+        std::vector<std::uint32_t>  _indices;
+        std::vector<lod::Level>     _levels;
+    };
+
+    /**
+     * Picks the coarsest level whose error projects to at most pixel_error pixels.
+     * distance is the view space distance of the object, scale the object to world scale.
+     * */
+    class GLCORE_EXPORT LodSelector
+    {
+        public:
+        LodSelector(float  viewport_height, float  vertical_fov, float  pixel_error = 1.f);
+
+        void set_viewport_height(float  viewport_height) noexcept;
+        void set_vertical_fov(float  vertical_fov) noexcept;
+        void set_pixel_error(float  pixel_error) noexcept;
+
+        [[nodiscard]] auto select(const LodChain  &chain, float  distance, float  scale = 1.f) const noexcept -> std::size_t;
+
+        //Draws the selected level, the index Buffer of vertex_array has to hold the chain
+        void draw(const VertexArray  &vertex_array, const LodChain  &chain, float  distance, float  scale = 1.f) const;
+
+        private:
+        float   _viewport_height;
+        float   _vertical_fov;
+        float   _pixel_error;
+    };
+}
+
+#endif
@@ -0,0 +1,111 @@
+
+
+#ifndef GLCORE_MEMORY_TRACKER_HPP
+#define GLCORE_MEMORY_TRACKER_HPP
+
+#include "glcore/glcore_export.h"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+namespace nitros::glcore
+{
+    namespace memory
+    {
+        enum class resource
+        {
+            buffer, texture, renderbuffer, staging
+        };
+
+        constexpr auto resource_count = std::size_t{4};
+
+        /**
+         * Tags the storage allocated while the scope is alive, scopes nest and the innermost tag wins.
+         * Objects keep their tag until they are destroyed, or are taken from the ObjectPool under another tag.
+         * */
+        class GLCORE_EXPORT TagScope
+        {
+            public:
+            explicit TagScope(std::string  tag);
+            TagScope(const TagScope &) = delete;
+            TagScope(TagScope &&) = delete;
+            ~TagScope();
+
+            TagScope& operator=(const TagScope &) = delete;
+            TagScope& operator=(TagScope &&) = delete;
+        };
+    }
+
+    /**
+     * Bytes of GPU storage held by Buffer, Texture, RenderBuffer and the staging buffers.
+     * The sizes are computed from the allocation requests, drivers may round them up.
+     * Objects kept by the ObjectPool stay accounted until the pool deletes them.
+     *
+     * The budget callback runs after the allocation which exceeds the budget, and again for every
+     * later allocation while the total stays above it. Objects destroyed inside the callback are accounted immediately.
+     * */
+    class GLCORE_EXPORT MemoryTracker
+    {
+        public:
+        using budget_callback = std::function<void(std::size_t  total_bytes, std::size_t  budget)>;
+
+        MemoryTracker(const MemoryTracker&) = delete;
+        MemoryTracker(MemoryTracker&&) = delete;
+
+        MemoryTracker& operator=(const MemoryTracker&) = delete;
+        MemoryTracker& operator=(MemoryTracker&&) = delete;
+
+        static MemoryTracker&  get_instance();
+
+        //Replaces the previous size of the object, untagged objects take the current TagScope tag
+        void record(memory::resource  type, std::uint32_t  id, std::size_t  bytes);
+        void erase(memory::resource  type, std::uint32_t  id);
+        void retag(memory::resource  type, std::uint32_t  id, const std::string  &tag);
+
+        //0 disables the budget
+        void set_budget(std::size_t  bytes, budget_callback  callback = {});
+        void reset_peak() noexcept;
+
+        [[nodiscard]] auto budget() const noexcept -> std::size_t;
+        [[nodiscard]] auto total_bytes() const noexcept -> std::size_t;
+        [[nodiscard]] auto peak_bytes() const noexcept -> std::size_t;
+        [[nodiscard]] auto bytes(memory::resource  type) const noexcept -> std::size_t;
+        [[nodiscard]] auto bytes(const std::string  &tag) const -> std::size_t;
+        [[nodiscard]] auto tags() const -> const std::map<std::string, std::size_t>&;
+        [[nodiscard]] auto object_count() const noexcept -> std::size_t;
+
+        private:
+        MemoryTracker();
+        ~MemoryTracker() = default;
+
+        struct Record
+        {
+            std::size_t     bytes;
+            std::string     tag;
+        };
+
+        void add(memory::resource  type, const std::string  &tag, std::size_t  bytes);
+        void remove(memory::resource  type, const std::string  &tag, std::size_t  bytes);
+        void check_budget();
+
+        std::map<std::pair<memory::resource, std::uint32_t>, Record>    _records;
+        std::array<std::size_t, memory::resource_count>     _resource_bytes;
+        std::map<std::string, std::size_t>  _tag_bytes;
+        std::vector<std::string>            _tag_stack;
+
+        std::size_t         _total;
+        std::size_t         _peak;
+        std::size_t         _budget;
+        budget_callback     _callback;
+        bool                _in_callback;
+
+        friend class memory::TagScope;
+    };
+}
+
+#endif
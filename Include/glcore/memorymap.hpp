@@ -13,6 +13,23 @@ namespace nitros::glcore
         enum class type {
             READ, WRITE, READ_WRITE
         };
+
+        //INVALIDATE_RANGE, INVALIDATE_BUFFER and UNSYNCHRONIZED are only valid with WRITE maps, EXPLICIT_FLUSH with WRITE and READ_WRITE maps
+        enum class flags : std::uint32_t {
+            NONE              = 0,
+            INVALIDATE_RANGE  = 1u << 0,
+            INVALIDATE_BUFFER = 1u << 1,
+            UNSYNCHRONIZED    = 1u << 2,
+            EXPLICIT_FLUSH    = 1u << 3
+        };
+
+        constexpr auto operator|(flags lhs, flags rhs) -> flags {
+            return static_cast<flags>( static_cast<std::uint32_t>(lhs) | static_cast<std::uint32_t>(rhs) );
+        }
+
+        constexpr auto has_flag(flags set, flags flag) -> bool {
+            return ( static_cast<std::uint32_t>(set) & static_cast<std::uint32_t>(flag) ) != 0;
+        }
     }
     
     template <_memorymap::type  type_ = _memorymap::type::READ_WRITE>
@@ -20,6 +37,9 @@ namespace nitros::glcore
     {
         public:
         explicit MemoryMap(const Buffer  &buffer);
+
+        //Maps the bytes [offset, offset + length) of the buffer
+        MemoryMap(const Buffer  &buffer, std::size_t  offset, std::size_t  length, _memorymap::flags  flags = _memorymap::flags::NONE);
         MemoryMap(const MemoryMap &) = delete;
         MemoryMap(MemoryMap &&) = delete;
         ~MemoryMap();
@@ -31,10 +51,19 @@ namespace nitros::glcore
 
         template <class type, std::size_t N>
         void get_data(gsl::span<std::array<type, N>>  &data) const;
+
+        //Offset relative to the mapped range, requires EXPLICIT_FLUSH
+        void flush(std::size_t  offset, std::size_t  length) const;
+
+        [[nodiscard]] auto offset() const noexcept -> std::size_t;
+        [[nodiscard]] auto length() const noexcept -> std::size_t;
         
         private:
         const Buffer&  _buffer;
         void *_buffer_ptr;
+        std::size_t         _offset;
+        std::size_t         _length;
+        _memorymap::flags   _flags;
     };
 
     template <_memorymap::type type_>
@@ -52,4 +81,4 @@ namespace nitros::glcore
 } // nitros::glcore
 
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,89 @@
+
+
+#ifndef GLCORE_MESH_OPTIMIZER_HPP
+#define GLCORE_MESH_OPTIMIZER_HPP
+
+#include "glcore/glcore_export.h"
+#include <gsl/gsl>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace nitros::glcore
+{
+    /**
+     * Offline processing of indexed triangle lists before they are written to a Buffer.
+     * Indices are 32 bit, narrow them after the optimization for 16 bit index Buffers.
+     *
+     * A typical order is optimize_vertex_cache, then optimize_overdraw on its result,
+     * then vertex_fetch_remap with remap_indices and remap_vertices.
+     * */
+    namespace mesh
+    {
+        //Post transform cache statistics of a FIFO cache simulation
+        struct CacheStats
+        {
+            std::size_t     vertices_transformed;
+            float           acmr;   //Transformed vertices per triangle, 0.5 at best and 3 at worst
+            float           atvr;   //Transformed vertices per referenced vertex, 1 at best
+        };
+
+        //table maps an old vertex to its new position, unreferenced vertices map to unused
+        struct Remap
+        {
+            static constexpr auto unused = std::numeric_limits<std::uint32_t>::max();
+
+            std::vector<std::uint32_t>  table;
+            std::size_t                 vertex_count;
+        };
+
+        [[nodiscard]] GLCORE_EXPORT auto analyze_vertex_cache(gsl::span<const std::uint32_t>  indices, std::size_t  vertex_count, std::uint32_t  cache_size = 16) -> CacheStats;
+
+        //Reorders the triangles for post transform cache hits with Tipsify (Sander, Nehab and Barczak 2007)
+        [[nodiscard]] GLCORE_EXPORT auto optimize_vertex_cache(gsl::span<const std::uint32_t>  indices, std::size_t  vertex_count, std::uint32_t  cache_size = 16) -> std::vector<std::uint32_t>;
+
+        /**
+         * Reorders clusters of a cache optimized index list so outward facing clusters are drawn first.
+         * positions holds vertex_count positions of 3 floats at position_stride floats apart.
+         * Clusters are split while their ACMR stays within threshold times the ACMR of the input.
+         * */
+        [[nodiscard]] GLCORE_EXPORT auto optimize_overdraw(gsl::span<const std::uint32_t>  indices, gsl::span<const float>  positions, std::size_t  position_stride = 3,
+                                                           std::uint32_t  cache_size = 16, float  threshold = 1.05f) -> std::vector<std::uint32_t>;
+
+        /**
+         * Quadric error metric edge collapse (Garland and Heckbert 1997) onto existing vertices, the vertex data stays shared.
+         * Collapses until at most target_index_count indices are left or the next collapse would move the surface
+         * further than target_error in position units. Open borders and attribute seams are held by heavily weighted border planes.
+         * Collapses that would flip a triangle or break the link condition of a manifold edge are skipped.
+         * result_error receives the largest error of the performed collapses.
+         * */
+        [[nodiscard]] GLCORE_EXPORT auto simplify(gsl::span<const std::uint32_t>  indices, gsl::span<const float>  positions, std::size_t  position_stride,
+                                                  std::size_t  target_index_count, float  target_error = std::numeric_limits<float>::max(),
+                                                  float*  result_error = nullptr) -> std::vector<std::uint32_t>;
+
+        //Orders the vertices by their first use in indices for sequential vertex fetches
+        [[nodiscard]] GLCORE_EXPORT auto vertex_fetch_remap(gsl::span<const std::uint32_t>  indices, std::size_t  vertex_count) -> Remap;
+
+        [[nodiscard]] GLCORE_EXPORT auto remap_indices(gsl::span<const std::uint32_t>  indices, const Remap  &remap) -> std::vector<std::uint32_t>;
+
+        //Drops the unreferenced vertices
+        template <class vertex_type>
+        [[nodiscard]] auto remap_vertices(gsl::span<const vertex_type>  vertices, const Remap  &remap) -> std::vector<vertex_type>
+        {
+            if(static_cast<std::size_t>(vertices.size()) != remap.table.size()) {
+                throw std::invalid_argument("Remap table doesn't match the vertex count");
+            }
+            auto remapped = std::vector<vertex_type>(remap.vertex_count);
+            for(auto v = std::size_t{0}; v < remap.table.size(); v++) {
+                if(remap.table[v] != Remap::unused) {
+                    remapped[remap.table[v]] = vertices[v];
+                }
+            }
+            return remapped;
+        }
+    }
+}
+
+#endif
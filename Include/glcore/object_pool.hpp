@@ -0,0 +1,102 @@
+
+
+#ifndef GLCORE_OBJECT_POOL_HPP
+#define GLCORE_OBJECT_POOL_HPP
+
+#include "glcore/glcore_export.h"
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <vector>
+#include <optional>
+
+namespace nitros::glcore
+{
+    namespace pool
+    {
+        enum class kind
+        {
+            buffer, texture, renderbuffer, framebuffer
+        };
+
+        //Objects with equal keys are interchangeable, width holds the size class of buffers
+        struct Key
+        {
+            kind            object;
+            std::uint32_t   target;     //Texture target, buffer usage or framebuffer color attachment count
+            std::uint32_t   format;     //Internal format, role target for buffers, depth and stencil attachment points of framebuffers
+            std::uint32_t   width;
+            std::uint32_t   height;
+            std::uint32_t   levels;
+        };
+
+        [[nodiscard]] GLCORE_EXPORT auto operator<(const Key  &lhs, const Key  &rhs) noexcept -> bool;
+    }
+
+    /**
+     * Recycles the storage of destroyed Buffer, Texture and RenderBuffer objects and the names of destroyed FrameBuffers.
+     * A destroyed object is kept up to the byte capacity and handed out to the next construction with the same key,
+     * which skips the glCreate* call and the storage allocation. The least recently released objects are deleted first.
+     *
+     * Pooling is disabled until set_capacity is called with a non zero capacity.
+     * Mutable Buffers are rounded up to a power of two size class, their id changes when the size class changes.
+     * FrameBuffers own no storage, they are detached on release and count framebuffer_bytes against the capacity.
+     * Pooled objects belong to the current context, call clear() before the context is destroyed.
+     * */
+    class GLCORE_EXPORT ObjectPool
+    {
+        public:
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool(ObjectPool&&) = delete;
+
+        ObjectPool& operator=(const ObjectPool&) = delete;
+        ObjectPool& operator=(ObjectPool&&) = delete;
+
+        static ObjectPool&  get_instance();
+
+        //Trims the pool down to the new capacity, 0 disables pooling
+        void set_capacity(std::size_t  bytes);
+
+        //Deletes the least recently released objects until at most bytes are pooled
+        void trim(std::size_t  bytes = 0);
+        void clear();
+
+        //Returns empty if no object with the key is pooled
+        [[nodiscard]] auto acquire(const pool::Key  &key) -> std::optional<std::uint32_t>;
+
+        //Returns false if the object doesn't fit in the pool, the caller deletes it
+        [[nodiscard]] auto release(const pool::Key  &key, std::uint32_t  id, std::size_t  bytes) -> bool;
+
+        [[nodiscard]] auto enabled() const noexcept -> bool;
+        [[nodiscard]] auto capacity() const noexcept -> std::size_t;
+        [[nodiscard]] auto pooled_bytes() const noexcept -> std::size_t;
+        [[nodiscard]] auto pooled_count() const noexcept -> std::size_t;
+
+        //Nominal size of a pooled FrameBuffer, bounds their count by the capacity
+        static constexpr std::size_t  framebuffer_bytes = 256;
+
+        //Next power of two, at least 256 bytes. 0 stays 0
+        [[nodiscard]] static auto size_class(std::size_t  size) noexcept -> std::size_t;
+
+        private:
+        ObjectPool();
+        ~ObjectPool() = default;
+
+        struct Entry
+        {
+            std::uint32_t   id;
+            std::size_t     bytes;
+            std::uint64_t   released;
+        };
+
+        void evict_oldest();
+
+        std::map<pool::Key, std::vector<Entry>>   _objects;
+        std::size_t     _capacity;
+        std::size_t     _pooled_bytes;
+        std::size_t     _pooled_count;
+        std::uint64_t   _release_counter;
+    };
+}
+
+#endif
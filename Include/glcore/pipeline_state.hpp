@@ -0,0 +1,153 @@
+
+
+#ifndef GLCORE_PIPELINE_STATE_HPP
+#define GLCORE_PIPELINE_STATE_HPP
+
+#include "glcore/glcore_export.h"
+#include "glcore/rasterizer.hpp"
+#include "glcore/framebuffer.hpp"
+#include "glcore/vertexarray.hpp"
+#include "glcore/shader.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace nitros::glcore
+{
+    namespace pipeline
+    {
+        enum class stencil_op
+        {
+            keep, zero, replace, increment, increment_wrap, decrement, decrement_wrap, invert
+        };
+
+        struct BlendState
+        {
+            bool                    enable = false;
+            FrameBuffer::factor     color_source      = FrameBuffer::factor::one;
+            FrameBuffer::factor     color_destination = FrameBuffer::factor::zero;
+            FrameBuffer::factor     alpha_source      = FrameBuffer::factor::one;
+            FrameBuffer::factor     alpha_destination = FrameBuffer::factor::zero;
+            utils::vec4f            color{0.f, 0.f, 0.f, 0.f};
+        };
+
+        struct DepthState
+        {
+            bool                    test  = true;
+            bool                    write = true;
+            FrameBuffer::comparison function = FrameBuffer::comparison::less;
+        };
+
+        struct StencilState
+        {
+            bool                    test = false;
+            FrameBuffer::comparison function = FrameBuffer::comparison::always;
+            std::int32_t            reference  = 0;
+            std::uint32_t           read_mask  = 0xFF;
+            std::uint32_t           write_mask = 0xFF;
+            stencil_op              stencil_fail = stencil_op::keep;
+            stencil_op              depth_fail   = stencil_op::keep;
+            stencil_op              pass         = stencil_op::keep;
+        };
+
+        struct RasterState
+        {
+            bool                        cull = false;
+            Rasterizer::cull            cull_face    = Rasterizer::cull::back;
+            Rasterizer::direction       front_face   = Rasterizer::direction::counter_clockwise;
+            Rasterizer::polygonMode     polygon_mode = Rasterizer::polygonMode::fill;   //Ignored in OpenGL ES
+            bool                        scissor_test = false;
+        };
+
+        //A null shader or vertex layout leaves the bound one unchanged
+        struct Description
+        {
+            const Shader*           shader        = nullptr;
+            const VertexArray*      vertex_layout = nullptr;
+            BlendState              blend;
+            DepthState              depth;
+            StencilState            stencil;
+            RasterState             raster;
+        };
+
+        [[nodiscard]] GLCORE_EXPORT auto operator==(const BlendState  &lhs, const BlendState  &rhs) noexcept -> bool;
+        [[nodiscard]] GLCORE_EXPORT auto operator==(const DepthState  &lhs, const DepthState  &rhs) noexcept -> bool;
+        [[nodiscard]] GLCORE_EXPORT auto operator==(const StencilState  &lhs, const StencilState  &rhs) noexcept -> bool;
+        [[nodiscard]] GLCORE_EXPORT auto operator==(const RasterState  &lhs, const RasterState  &rhs) noexcept -> bool;
+        [[nodiscard]] GLCORE_EXPORT auto operator==(const Description  &lhs, const Description  &rhs) noexcept -> bool;
+
+        [[nodiscard]] GLCORE_EXPORT auto hash(const Description  &description) noexcept -> std::size_t;
+    }
+
+    /**
+     * Immutable bundle of shader, vertex layout and fixed function state, created through PipelineCache::intern.
+     * Equal descriptions share one PipelineState, so states compare by address and id() is a stable sort key.
+     * */
+    class GLCORE_EXPORT PipelineState
+    {
+        public:
+        PipelineState(const PipelineState&) = delete;
+        PipelineState(PipelineState&&) = delete;
+
+        PipelineState& operator=(const PipelineState&) = delete;
+        PipelineState& operator=(PipelineState&&) = delete;
+
+        [[nodiscard]] auto description() const noexcept -> const pipeline::Description&;
+        [[nodiscard]] auto hash() const noexcept -> std::size_t;
+
+        //Dense id in intern order, stays the same until PipelineCache::clear
+        [[nodiscard]] auto id() const noexcept -> std::uint32_t;
+
+        private:
+        friend class PipelineCache;
+
+        PipelineState(const pipeline::Description  &description, std::size_t  hash, std::uint32_t  id);
+
+        pipeline::Description   _description;
+        std::size_t             _hash;
+        std::uint32_t           _id;
+    };
+
+    /**
+     * Interns PipelineStates and applies them. apply() only issues the GL calls for the parts
+     * which differ from the last applied state, capabilities also go through the StateCache.
+     *
+     * Call reset() after blend, depth, stencil or raster state was changed outside of apply(),
+     * e.g. through Rasterizer or FrameBuffer, the next apply() then sets the whole state.
+     * */
+    class GLCORE_EXPORT PipelineCache
+    {
+        public:
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache(PipelineCache&&) = delete;
+
+        PipelineCache& operator=(const PipelineCache&) = delete;
+        PipelineCache& operator=(PipelineCache&&) = delete;
+
+        static PipelineCache&  get_instance();
+
+        [[nodiscard]] auto intern(const pipeline::Description  &description) -> const PipelineState&;
+
+        void apply(const PipelineState  &state);
+        void reset() noexcept;
+
+        //Destroys every interned state, references returned by intern become dangling
+        void clear() noexcept;
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+        [[nodiscard]] auto last_applied() const noexcept -> const PipelineState*;
+
+        private:
+        PipelineCache() = default;
+        ~PipelineCache() = default;
+
+        std::unordered_map<std::size_t, std::vector<std::unique_ptr<PipelineState>>>  _states;
+        std::uint32_t           _next_id = 0;
+        const PipelineState*    _current = nullptr;
+    };
+}
+
+#endif
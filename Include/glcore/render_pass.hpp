@@ -0,0 +1,52 @@
+
+
+#ifndef GLCORE_RENDER_PASS_HPP
+#define GLCORE_RENDER_PASS_HPP
+
+#include "glcore/glcore_export.h"
+#include "glcore/framebuffer.hpp"
+#include "glcore/common_processing.hpp"
+#include "glcore/pipeline_state.hpp"
+#include "glcore/render_queue.hpp"
+
+#include <array>
+#include <optional>
+#include <cstdint>
+
+namespace nitros::glcore
+{
+    /**
+     * Scope of many draws into one FrameBuffer. The constructor binds the framebuffer, viewport and pipeline once,
+     * draws of VertexArrays inside the scope leave their bindings in place for the next draw.
+     * The destructor unbinds the VertexArray and restores the framebuffers, viewport and pipeline of before the pass.
+     *
+     * A null framebuffer renders to the default FrameBuffer. Passes nest, but must be destroyed in reverse order.
+     * */
+    class GLCORE_EXPORT RenderPass
+    {
+        public:
+        explicit RenderPass(const FrameBuffer*  framebuffer, const std::optional<ViewDim>  &viewport = std::nullopt, const PipelineState*  pipeline = nullptr);
+        RenderPass(const RenderPass&) = delete;
+        RenderPass(RenderPass&&) = delete;
+        ~RenderPass();
+
+        RenderPass& operator=(const RenderPass&) = delete;
+        RenderPass& operator=(RenderPass&&) = delete;
+
+        //Applies only the state differing from the current pipeline
+        void set_pipeline(const PipelineState  &pipeline);
+        void bind_texture(const render::TextureBinding  &binding);
+
+        [[nodiscard]] auto get_framebuffer() const noexcept -> const FrameBuffer*;
+
+        private:
+        const FrameBuffer*      _framebuffer;
+        std::uint32_t           _previous_draw_framebuffer;
+        std::uint32_t           _previous_read_framebuffer;
+        std::array<std::int32_t, 4>     _previous_viewport;
+        bool                    _viewport_changed;
+        const PipelineState*    _previous_pipeline;
+    };
+}
+
+#endif
@@ -0,0 +1,119 @@
+
+
+#ifndef GLCORE_RENDER_QUEUE_HPP
+#define GLCORE_RENDER_QUEUE_HPP
+
+#include "glcore/glcore_export.h"
+#include "glcore/textures.h"
+#include "glcore/framebuffer.hpp"
+#include "glcore/vertexarray.hpp"
+#include "glcore/shader.h"
+
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+namespace nitros::glcore
+{
+    namespace render
+    {
+        struct TextureBinding
+        {
+            std::uint32_t       unit;
+            texture::target     target;
+            std::uint32_t       id;
+        };
+
+        template <texture::type T_>
+        auto texture_binding(std::uint32_t  unit, const Texture<T_>  &texture) -> TextureBinding {
+            return { unit, texture.get_target(), texture.get_id() };
+        }
+
+        //Rasterizer capabilities of a draw
+        struct RasterState
+        {
+            bool    blend        = false;
+            bool    depth_test   = true;
+            bool    cull_face    = false;
+            bool    scissor_test = false;
+        };
+
+        /**
+         * One draw of the whole VertexArray.
+         * layer orders passes, lower first, in [0, max_layer]. A null framebuffer draws to the default FrameBuffer.
+         * depth is the view space distance, opaque items are drawn front to back inside a state group,
+         * translucent items back to front before any state grouping.
+         * */
+        struct DrawItem
+        {
+            static constexpr std::uint8_t   max_layer = 15;
+
+            std::uint8_t            layer        = 0;
+            const FrameBuffer*      framebuffer  = nullptr;
+            Shader*                 shader       = nullptr;
+            const VertexArray*      vertex_array = nullptr;
+            std::vector<TextureBinding>     textures;
+            RasterState             raster;
+            bool                    translucent  = false;
+            float                   depth        = 0.f;
+            std::uint32_t           instance_count = 1;
+
+            //Sets the per item uniforms, called after the shader is in use
+            std::function<void(Shader&)>    uniforms;
+        };
+    }
+
+    /**
+     * Collects the draws of a frame and submits them sorted by a 64 bit key to minimize state changes.
+     *
+     * Key from msb: layer(4) framebuffer(6) translucent(1) then
+     * opaque:      shader(10) raster(4) textures(12) vertex array(11) depth(16)
+     * translucent: inverted depth(16) shader(10) raster(4) textures(12) vertex array(11)
+     *
+     * Shaders, texture sets and vertex arrays get dense ids in push order, ids beyond the bit width wrap
+     * which only costs grouping. submit() only changes the state that differs from the previous item
+     * and assumes nothing else changes the GL state while it runs.
+     * */
+    class GLCORE_EXPORT RenderQueue
+    {
+        public:
+        struct Stats
+        {
+            std::size_t     draws;
+            std::size_t     framebuffer_changes;
+            std::size_t     shader_changes;
+            std::size_t     raster_changes;
+            std::size_t     texture_changes;
+            std::size_t     vertex_array_changes;
+        };
+
+        RenderQueue() = default;
+
+        //Throws std::invalid_argument without shader or vertex array, std::out_of_range for a layer above DrawItem::max_layer
+        void push(render::DrawItem  item);
+
+        //Sorts and draws the items and clears the queue
+        void submit();
+        void clear();
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+        [[nodiscard]] auto last_stats() const noexcept -> const Stats&;
+
+        private:
+        void sort();
+
+        std::vector<render::DrawItem>   _items;
+        std::vector<std::uint64_t>      _keys;
+        std::vector<std::uint32_t>      _order;
+        std::vector<std::uint32_t>      _scratch;
+
+        std::unordered_map<const void*, std::uint32_t>      _framebuffer_ids;
+        std::unordered_map<const void*, std::uint32_t>      _shader_ids;
+        std::unordered_map<const void*, std::uint32_t>      _vertex_array_ids;
+        std::unordered_map<std::uint64_t, std::uint32_t>    _texture_set_ids;
+
+        Stats   _stats{};
+    };
+}
+
+#endif
@@ -20,6 +20,7 @@ namespace nitros::glcore
             std::string  geometry;
             std::string  tess_control;
             std::string  tess_evaluation;
+            std::string  compute;   //Linked alone, see ComputeProgram
         };
     }
 
@@ -31,11 +32,12 @@ namespace nitros::glcore
         explicit Shader(const std::uint32_t  &id, bool owning = false);
 
         Shader(const Shader&) = delete;
-        Shader(Shader &&) = default;
+        //The moved from Shader stops owning the program
+        Shader(Shader &&other) noexcept;
         ~Shader();
 
         Shader& operator=(const Shader&) = delete;
-        Shader& operator=(Shader&&) = default;
+        Shader& operator=(Shader&&  other) noexcept;
 
         void use() const;
         void set_uniform_matrix4fv(const std::string &name, const glm::mat4  &mat, bool transpose = false);
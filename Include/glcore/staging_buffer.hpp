@@ -6,6 +6,7 @@
 #include <glcore/globj.hpp>
 #include "glcore/buffer.hpp"
 #include "glcore/textures.h"
+#include <chrono>
 
 namespace nitros::glcore
 {
@@ -46,6 +47,9 @@ namespace nitros::glcore
 
         auto commands_complete() const -> bool;
 
+        //Blocks until the commands before the fence complete or the timeout expires, returns true when complete
+        auto wait(std::chrono::nanoseconds  timeout) const -> bool;
+
         private:
         void*   _sync_ptr;  
     };
@@ -70,6 +74,48 @@ namespace nitros::glcore
         utils::Uptr<utils::ImageMetaData>    _meta_data;
     };
 
+    /**
+     * Asynchronous read back of a Buffer range.
+     * The range is copied on the GPU into a client side staging buffer followed by a Fence,
+     * poll is_ready or wait with a timeout before get to read without draining the pipeline.
+     * */
+    class GLCORE_EXPORT BufferReadback : public GLobj
+    {
+        public:
+        explicit BufferReadback(const Buffer  &buffer);
+        BufferReadback(const Buffer  &buffer, std::size_t  offset, std::size_t  length);
+        BufferReadback(const BufferReadback &) = delete;
+        BufferReadback(BufferReadback &&) = delete;
+        ~BufferReadback();
+
+        auto operator=(const BufferReadback &) -> BufferReadback& = delete;
+        auto operator=(BufferReadback &&) -> BufferReadback& = delete;
+
+        [[nodiscard]] auto is_ready() const -> bool;
+        auto wait(std::chrono::nanoseconds  timeout) const -> bool;
+
+        //Blocks until the copy completes when not ready
+        void get(gsl::span<std::uint8_t>  data) const;
+
+        template <class type, std::size_t N>
+        void get(std::vector<std::array<type, N>>  &data) const;
+
+        [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+        private:
+        std::size_t             _size;
+        utils::Uptr<Fence>      _fence;
+    };
+
+    template <class type, std::size_t N>
+    void BufferReadback::get(std::vector<std::array<type, N>>  &data) const
+    {
+        static_assert(N > 0 && N <= 4);
+        constexpr auto stride = sizeof(std::array<type, N>);
+        data.resize(_size / stride);
+        get( gsl::span<std::uint8_t>{reinterpret_cast<std::uint8_t*>(data.data()), gsl::narrow_cast<std::ptrdiff_t>( data.size() * stride ) } );
+    }
+
     extern template GLCORE_EXPORT auto StageBufferRead::stage_data(texture::ImageView<texture::type::color>  &image) -> utils::Uptr<Fence>;
     extern template GLCORE_EXPORT auto StageBufferRead::stage_data(texture::ImageView<texture::type::depth>  &image) -> utils::Uptr<Fence>;
     extern template GLCORE_EXPORT auto StageBufferRead::stage_data(texture::ImageView<texture::type::depth_stencil>  &image) -> utils::Uptr<Fence>;
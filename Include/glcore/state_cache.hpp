@@ -0,0 +1,110 @@
+
+
+#ifndef GLCORE_STATE_CACHE_HPP
+#define GLCORE_STATE_CACHE_HPP
+
+#include "glcore/glcore_export.h"
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <map>
+#include <utility>
+
+namespace nitros::glcore
+{
+    /**
+     * Shadow copy of the GL state changed by glcore: program, vertex array, framebuffers, texture units,
+     * capabilities, viewport and scissor. Calls which wouldn't change the state are skipped.
+     *
+     * There is one cache for the current context. Call reset() after switching the context or after code
+     * outside glcore changed GL state, every following call goes to GL once until the state is known again.
+     * Targets and capabilities are GL enums.
+     *
+     * The get_ functions answer from the shadow copy and only query GL while the state isn't known yet.
+     * With verify on they always query GL, log a warning when the shadow copy differs and return the GL value.
+     * */
+    class GLCORE_EXPORT StateCache
+    {
+        public:
+        struct Stats
+        {
+            std::size_t     issued;
+            std::size_t     skipped;
+        };
+
+        //x, y, width, height
+        using rect = std::array<std::int32_t, 4>;
+
+        StateCache(const StateCache&) = delete;
+        StateCache(StateCache&&) = delete;
+
+        StateCache& operator=(const StateCache&) = delete;
+        StateCache& operator=(StateCache&&) = delete;
+
+        static StateCache&  get_instance();
+
+        void reset() noexcept;
+
+        //Disabled the cache forwards every call
+        void set_enabled(bool  enable) noexcept;
+        [[nodiscard]] auto is_enabled() const noexcept -> bool;
+
+        //Debug mode, every get_ function queries GL
+        void set_verify(bool  verify) noexcept;
+        [[nodiscard]] auto is_verifying() const noexcept -> bool;
+
+        void use_program(std::uint32_t  program);
+        void bind_vertex_array(std::uint32_t  vertex_array);
+
+        //GL_FRAMEBUFFER binds both the draw and the read framebuffer
+        void bind_framebuffer(std::uint32_t  target, std::uint32_t  framebuffer);
+
+        void active_texture(std::uint32_t  unit);
+        //Binds to the active unit
+        void bind_texture(std::uint32_t  target, std::uint32_t  texture);
+        void bind_texture_unit(std::uint32_t  unit, std::uint32_t  target, std::uint32_t  texture);
+
+        void set_capability(std::uint32_t  capability, bool  enable);
+
+        void viewport(std::int32_t  x, std::int32_t  y, std::int32_t  width, std::int32_t  height);
+        void scissor(std::int32_t  x, std::int32_t  y, std::int32_t  width, std::int32_t  height);
+
+        [[nodiscard]] auto get_program() -> std::uint32_t;
+        //GL_DRAW_FRAMEBUFFER or GL_READ_FRAMEBUFFER
+        [[nodiscard]] auto get_framebuffer(std::uint32_t  target) -> std::uint32_t;
+        [[nodiscard]] auto get_capability(std::uint32_t  capability) -> bool;
+        [[nodiscard]] auto get_viewport() -> rect;
+        [[nodiscard]] auto get_scissor() -> rect;
+
+        //GL unbinds deleted objects and reuses their names, call before deleting
+        void forget_program(std::uint32_t  program) noexcept;
+        void forget_vertex_array(std::uint32_t  vertex_array) noexcept;
+        void forget_framebuffer(std::uint32_t  framebuffer) noexcept;
+        void forget_texture(std::uint32_t  texture) noexcept;
+
+        [[nodiscard]] auto stats() const noexcept -> const Stats&;
+
+        private:
+        StateCache();
+        ~StateCache() = default;
+
+        [[nodiscard]] auto skip(bool  unchanged) noexcept -> bool;
+
+        bool            _enabled;
+        bool            _verify;
+        std::uint32_t   _program;
+        std::uint32_t   _vertex_array;
+        std::uint32_t   _draw_framebuffer;
+        std::uint32_t   _read_framebuffer;
+        std::uint32_t   _active_unit;
+        std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t>   _textures;
+        std::map<std::uint32_t, bool>   _capabilities;
+        rect            _viewport;
+        rect            _scissor;
+        bool            _viewport_known;
+        bool            _scissor_known;
+        Stats           _stats;
+    };
+}
+
+#endif
@@ -243,6 +243,7 @@ class GLCORE_EXPORT Texture : public GLobj
     void texture_realloc_cube_map(const gsl::span<const utils::Image<buffer_type_>, 6>  &images, bool mipmap = true);
     
     void desired_texture_parameters(utils::Uptr<Parameters>  params);
+    //Served from the parameters set through glcore, queried from GL when the StateCache verifies
     [[nodiscard]] auto current_texture_parameters() const -> Parameters;
     
     void bind() const;
@@ -258,6 +259,7 @@ class GLCORE_EXPORT Texture : public GLobj
 
     private:
     void texture_parameters(const Parameters  &params);
+    [[nodiscard]] auto query_texture_parameters() const -> Parameters;
     void alloc_storage(const texture::target  &target, const utils::ImageMetaData &meta_data, bool mip_map);
     void copy_data(const std::uint32_t  &level, const utils::vec2Ui  &offset, const utils::vec2Ui  &dim, const utils::pixel::Format  &format, const gsl::span<const std::uint8_t>  &data);
     void copy_data(const std::uint32_t  &level, const utils::vec2Ui  &offset, const utils::vec2Ui  &dim, const utils::pixel::Format  &format, const std::array<gsl::span<const std::uint8_t>, 6>  &data);
@@ -266,6 +268,8 @@ class GLCORE_EXPORT Texture : public GLobj
     bool            _mip_map;
     utils::Uptr<Parameters>     _params;
     utils::Uptr<utils::ImageMetaData>        _meta_data;
+    Parameters      _current_params;
+    std::uint32_t   _storage_levels;    //Levels of the allocated storage, 0 without storage
 };
 
 using ColorTexture = Texture<texture::type::color>;
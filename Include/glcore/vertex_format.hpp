@@ -0,0 +1,73 @@
+
+
+#ifndef GLCORE_VERTEX_FORMAT_HPP
+#define GLCORE_VERTEX_FORMAT_HPP
+
+#include "glcore/glcore_export.h"
+#include "glcore/buffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace nitros::glcore
+{
+    /**
+     * CPU side conversion of float attributes into the compact Buffer formats.
+     * Write the result with Buffer::write_data(data, true) for the normalized integer and packed formats.
+     * */
+    namespace vertex_format
+    {
+        [[nodiscard]] GLCORE_EXPORT auto to_half(float value) noexcept -> buffer::half;
+        [[nodiscard]] GLCORE_EXPORT auto from_half(buffer::half  value) noexcept -> float;
+
+        //Components are clamped to [-1, 1], w to the 2 bit range [-1, 1]
+        [[nodiscard]] GLCORE_EXPORT auto pack_2_10_10_10(const utils::vec4f  &value) noexcept -> buffer::packed_2_10_10_10;
+        [[nodiscard]] GLCORE_EXPORT auto unpack_2_10_10_10(buffer::packed_2_10_10_10  value) noexcept -> utils::vec4f;
+
+        //Unsigned types map [0, 1], signed types map [-1, 1]
+        template <class type>
+        [[nodiscard]] auto quantize(float value) noexcept -> type
+        {
+            static_assert(std::is_integral_v<type> && sizeof(type) <= 2, "Quantize to 8 or 16 bit integers");
+            constexpr auto max_value = static_cast<float>( std::numeric_limits<type>::max() );
+
+            if constexpr(std::is_unsigned_v<type>) {
+                return static_cast<type>( std::lround( std::clamp(value, 0.0f, 1.0f) * max_value ) );
+            }
+            else {
+                return static_cast<type>( std::lround( std::clamp(value, -1.0f, 1.0f) * max_value ) );
+            }
+        }
+
+        template <class type, std::size_t N>
+        [[nodiscard]] auto quantize(const std::vector<std::array<float, N>>  &data) -> std::vector<std::array<type, N>>
+        {
+            auto quantized = std::vector<std::array<type, N>>(data.size());
+            for(auto i = std::size_t{0}; i < data.size(); ++i) {
+                for(auto c = std::size_t{0}; c < N; ++c) {
+                    quantized[i][c] = quantize<type>(data[i][c]);
+                }
+            }
+            return quantized;
+        }
+
+        template <std::size_t N>
+        [[nodiscard]] auto to_half(const std::vector<std::array<float, N>>  &data) -> std::vector<std::array<buffer::half, N>>
+        {
+            auto halfs = std::vector<std::array<buffer::half, N>>(data.size());
+            for(auto i = std::size_t{0}; i < data.size(); ++i) {
+                for(auto c = std::size_t{0}; c < N; ++c) {
+                    halfs[i][c] = to_half(data[i][c]);
+                }
+            }
+            return halfs;
+        }
+
+        //Normals and tangents, the missing w is written as w_value
+        [[nodiscard]] GLCORE_EXPORT auto pack_2_10_10_10(const std::vector<utils::vec3f>  &data, float w_value = 0.0f) -> std::vector<std::array<buffer::packed_2_10_10_10, 1>>;
+        [[nodiscard]] GLCORE_EXPORT auto pack_2_10_10_10(const std::vector<utils::vec4f>  &data) -> std::vector<std::array<buffer::packed_2_10_10_10, 1>>;
+    } // namespace vertex_format
+} // namespace nitros::glcore
+
+
+#endif
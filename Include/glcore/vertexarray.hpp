@@ -6,10 +6,96 @@
 #include "globj.hpp"
 #include <map>
 #include <memory>
+#include <optional>
+#include <vector>
+#include <limits>
 #include "buffer.hpp"
+#include "buffer_heap.hpp"
 
 namespace nitros::glcore
 {
+    class IndirectCommandBuffer;
+
+    namespace vertex
+    {
+        struct AttributeFormat
+        {
+            std::uint32_t       location;
+            std::uint32_t       components;
+            Buffer::value_type  type;
+            bool                normalized;
+            bool                integer;
+            std::size_t         offset;
+        };
+
+        /**
+         * Member of an interleaved vertex struct
+         * Location: shader attribute location, Member: decltype(Vertex::member), Offset: offsetof(Vertex, member)
+         * */
+        template <std::uint32_t Location, class Member, std::size_t Offset, bool Normalized = false>
+        struct Attribute;
+
+        template <std::uint32_t Location, class type, std::size_t N, std::size_t Offset, bool Normalized>
+        struct Attribute<Location, std::array<type, N>, Offset, Normalized>
+        {
+            static_assert(N > 0 && N <= 4);
+            static constexpr std::size_t size   = sizeof(std::array<type, N>);
+            static constexpr std::size_t offset = Offset;
+
+            static constexpr auto format() -> AttributeFormat
+            {
+                constexpr auto v_type    = internal::to_value_type<type>();
+                constexpr auto is_packed = v_type == Buffer::value_type::INT_2_10_10_10;
+                static_assert(!is_packed || N == 1, "Packed 2_10_10_10 holds 4 components in one element");
+
+                return {
+                    Location,
+                    is_packed ? 4u : static_cast<std::uint32_t>(N),
+                    v_type,
+                    (std::is_integral_v<type> || is_packed) && Normalized,
+                    std::is_integral_v<type> && !Normalized,
+                    Offset
+                };
+            }
+        };
+
+        /**
+         * Compile time description of an interleaved vertex struct
+         * 
+         * struct Vertex { utils::vec3f position; utils::vec2f uv; };
+         * using layout = Layout<Vertex, Attribute<0, decltype(Vertex::position), offsetof(Vertex, position)>,
+         *                               Attribute<1, decltype(Vertex::uv), offsetof(Vertex, uv)>>;
+         * */
+        template <class Vertex, class ... Attributes>
+        struct Layout
+        {
+            static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex must be trivially copyable");
+            static_assert(( (Attributes::offset + Attributes::size <= sizeof(Vertex)) && ... ), "Attribute exceeds the Vertex");
+
+            using vertex_type = Vertex;
+            static constexpr std::size_t stride = sizeof(Vertex);
+            static constexpr std::array<AttributeFormat, sizeof...(Attributes)> attributes{ Attributes::format()... };
+        };
+
+        //Mesh inside shared vertex and index buffers, first_index in indices and base_vertex added to every index
+        struct MeshRange
+        {
+            std::uint32_t   first_index;
+            std::uint32_t   count;
+            std::int32_t    base_vertex;
+        };
+
+        //Buffer bound to one binding point, divisor 0 steps per vertex and N > 0 every N instances
+        struct Binding
+        {
+            std::shared_ptr<const GLobj>    buffer;
+            std::size_t                     offset;
+            std::size_t                     stride;
+            std::uint32_t                   divisor;
+            std::vector<AttributeFormat>    attributes;
+        };
+    }
+
     class GLCORE_EXPORT VertexArray : public GLobj
     {
         public:
@@ -20,9 +106,18 @@ namespace nitros::glcore
             line_strip,
             line_loop,
             triangles,
+            triangle_strip,
+            triangle_fan,
             patches
         };
 
+        //Restart index of the fixed index primitive restart, the maximum value of the index type
+        template <class type>
+        static constexpr auto restart_index() noexcept -> type {
+            static_assert(std::is_same_v<type, std::uint32_t> || std::is_same_v<type, std::uint16_t> || std::is_same_v<type, std::uint8_t>);
+            return std::numeric_limits<type>::max();
+        }
+
         explicit VertexArray();
         VertexArray(const VertexArray &) = delete;
         VertexArray(VertexArray &&) = default;
@@ -31,18 +126,142 @@ namespace nitros::glcore
         VertexArray& operator=(const VertexArray &) = delete;
         VertexArray& operator=(VertexArray &&) = default;
 
+        //Specifies the attributes once after a change of buffers, afterwards only binds. Leaves the VertexArray bound
         void bind() const;
+        //Draws leave the VertexArray bound, a RenderPass unbinds it at the end of the pass
         void draw() const;
+        void draw_arrays(std::uint32_t  first, std::uint32_t  count) const;
         void draw_index_count(std::uint32_t  index_offset, std::uint32_t  index_count) const;
+
+        //Draws instance_count instances, base_instance offsets the per instance attributes. OpenGL ES has no base instance
+        void draw_instanced(std::uint32_t  instance_count, std::uint32_t  base_instance = 0) const;
+        void draw_arrays_instanced(std::uint32_t  first, std::uint32_t  count, std::uint32_t  instance_count, std::uint32_t  base_instance = 0) const;
+        void draw_index_count_instanced(std::uint32_t  index_offset, std::uint32_t  index_count, std::uint32_t  instance_count, std::uint32_t  base_instance = 0) const;
+
+        //Index Buffer draws of one mesh in shared buffers, OpenGL ES 3.0 has no base vertex and throws for non zero
+        void draw_range(const vertex::MeshRange  &range) const;
+        void draw_range_instanced(const vertex::MeshRange  &range, std::uint32_t  instance_count, std::uint32_t  base_instance = 0) const;
+
+        //Draws all ranges with a single glMultiDrawElementsBaseVertex on OpenGL core
+        void draw_ranges(gsl::span<const vertex::MeshRange>  ranges) const;
+
+        //Draws count commands from first in one call, element commands need the index Buffer
+        void draw_indirect(const IndirectCommandBuffer  &commands, std::size_t  first = 0, std::size_t  count = std::numeric_limits<std::size_t>::max()) const;
+
+        //Step rate of the attribute Buffer at location in buffers, 0 steps per vertex and N > 0 every N instances
+        void set_divisor(std::uint32_t  location, std::uint32_t  divisor);
+        [[nodiscard]] auto get_divisor(std::uint32_t  location) const -> std::uint32_t;
         void set_draw_mode(draw_mode    mode, const std::uint32_t  &patch_vertices = {});
 
+        //Index buffers of UINT, USHORT or UBYTE, restart_index of the index type ends a strip. Always on in OpenGL ES
+        void set_primitive_restart(bool enable) noexcept;
+
+        //Interleaved buffer described by a vertex::Layout, offset in bytes to the first vertex
+        //Binding indices are shared with the attribute indices of buffers, don't use an index of buffers as binding
+        template <class Layout, class BufferT>
+        void set_vertex_buffer(std::uint32_t  binding, std::shared_ptr<BufferT>  buffer, std::uint32_t  divisor = 0, std::size_t  offset = 0);
+
+        //Swaps the buffer of an existing binding keeping its layout, a single call on OpenGL 4.5
+        template <class BufferT>
+        void rebind_vertex_buffer(std::uint32_t  binding, std::shared_ptr<BufferT>  buffer, std::size_t  offset = 0);
+
+        //Indices of type UINT, USHORT or UBYTE in the range of handle, used while index is empty. Draws count indices from the handle offset
+        //Indirect draws count first_index from the start of the heap. WebGL needs a heap holding only indices
+        void set_index_heap(std::shared_ptr<const BufferHeap>  heap, BufferHeap::Handle  handle, Buffer::value_type  type);
+        void reset_index_heap() noexcept;
+
         std::map<std::uint32_t, std::shared_ptr<Buffer>>  buffers;
         std::shared_ptr<Buffer>     index;
 
         private:
+        //write_data may change the buffer object and the row layout of a Buffer
+        struct BufferState
+        {
+            const Buffer*       buffer;
+            std::uint32_t       id;
+            std::size_t         stride;
+            std::size_t         components;
+            Buffer::value_type  type;
+            bool                normalized;
+        };
+
+        //Bound element buffer object, offset in bytes to the first index and count of indices after it
+        struct ElementSource
+        {
+            std::uint32_t       id;
+            std::size_t         offset;
+            std::size_t         count;
+            Buffer::value_type  type;
+        };
+
+        struct Specification
+        {
+            std::map<std::uint32_t, BufferState>        buffers;
+            BufferState                                 index;
+            std::uint32_t                               index_heap;
+            std::map<std::uint32_t, std::uint32_t>      binding_ids;
+            std::vector<std::uint32_t>                  enabled_locations;
+            bool                                        dirty;
+        };
+
+        void set_binding(std::uint32_t  binding, vertex::Binding  &&vertex_binding);
+        void rebind(std::uint32_t  binding, std::shared_ptr<const GLobj>  &&buffer, std::size_t  offset);
+        void bind_vertex_array() const;
+        [[nodiscard]] static auto buffer_state(const std::shared_ptr<Buffer>  &buffer) -> BufferState;
+        [[nodiscard]] static auto same_state(const BufferState  &state, const std::shared_ptr<Buffer>  &buffer) -> bool;
+        [[nodiscard]] auto specification_changed() const -> bool;
+        void specify() const;
+        void apply_primitive_restart() const;
+        [[nodiscard]] auto vertex_count() const -> std::uint32_t;
+        [[nodiscard]] auto element_source() const -> std::optional<ElementSource>;
+        [[nodiscard]] auto element_id() const -> std::uint32_t;
+        void draw_elements(const ElementSource  &elements, std::uint32_t  index_offset, std::size_t  index_count, std::uint32_t  instance_count, std::uint32_t  base_instance, std::int32_t  base_vertex = 0) const;
+        [[nodiscard]] static auto clamp_index_count(const ElementSource  &elements, std::uint32_t  index_offset, std::size_t  index_count) -> std::size_t;
+        void draw_vertices(std::uint32_t  first, std::uint32_t  count, std::uint32_t  instance_count, std::uint32_t  base_instance) const;
+
         draw_mode     _draw_mode;
+        bool          _primitive_restart;
         std::uint32_t   _vertices_per_primtive;
+        std::uint32_t   _vertex_count;
+        std::map<std::uint32_t, vertex::Binding>    _bindings;
+        std::map<std::uint32_t, std::uint32_t>      _divisors;
+        std::shared_ptr<const BufferHeap>           _index_heap;
+        BufferHeap::Handle                          _index_handle;
+        Buffer::value_type                          _index_type;
+        mutable Specification                       _specification;
     };
+
+    template <class Layout, class BufferT>
+    void VertexArray::set_vertex_buffer(std::uint32_t  binding, std::shared_ptr<BufferT>  buffer, std::uint32_t  divisor, std::size_t  offset)
+    {
+        using buffer_t = std::remove_const_t<BufferT>;
+        static_assert(std::is_same_v<buffer_t, Buffer> || std::is_same_v<buffer_t, StreamBuffer> || std::is_same_v<buffer_t, BufferHeap>,
+            "Vertex buffers must be a Buffer, StreamBuffer or BufferHeap");
+
+        if constexpr(std::is_same_v<buffer_t, Buffer>) {
+            if(divisor == 0 && buffer->size_bytes() >= offset) {
+                _vertex_count = gsl::narrow_cast<std::uint32_t>( (buffer->size_bytes() - offset) / Layout::stride );
+            }
+        }
+
+        set_binding(binding, vertex::Binding{
+            std::move(buffer),
+            offset,
+            Layout::stride,
+            divisor,
+            std::vector<vertex::AttributeFormat>( Layout::attributes.begin(), Layout::attributes.end() )
+        });
+    }
+
+    template <class BufferT>
+    void VertexArray::rebind_vertex_buffer(std::uint32_t  binding, std::shared_ptr<BufferT>  buffer, std::size_t  offset)
+    {
+        using buffer_t = std::remove_const_t<BufferT>;
+        static_assert(std::is_same_v<buffer_t, Buffer> || std::is_same_v<buffer_t, StreamBuffer> || std::is_same_v<buffer_t, BufferHeap>,
+            "Vertex buffers must be a Buffer, StreamBuffer or BufferHeap");
+
+        rebind(binding, std::move(buffer), offset);
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -12,6 +12,7 @@
 #include "glcore/vertexarray.hpp"
 #include "glcore/rasterizer.hpp"
 #include "glcore/common_processing.hpp"
+#include "glcore/render_pass.hpp"
 #include "glcore/rasterizer.hpp"
 
 #include <glm/glm.hpp>
@@ -152,51 +153,46 @@ int main(int argc, char const *argv[])
         window.run([&]()
         {    
             //First
-            glcore::ViewPort::dimension(first_pass_dim);
-
-            fbo2.bind();
-            fbo2.clear_color({0.2f, 0.2, 0.2, 0.0f});
-            fbo2.clear_depth();
-
-            print_error();
-
             auto delta_time = Time2::delta_time();
 
             srt.rotate.y += (glm::radians(45.f)*delta_time.count()/1000.0);
             auto model = model_matrix(srt);
 
-            shader.use();
-            shader.set_uniform_matrix4fv("mvp", projection *  model);
-            shader.set_uniform("height_map", utils::vec1i{0});
-            shader.set_uniform("diffuse_map", utils::vec1i{1});
-            height_texture.active_bind(0);
-            color_texture.active_bind(1);
-            vao.draw();
-
-            //Second Pass
-
-            glcore::ViewPort::dimension(default_pass_dim);
+            {
+                auto pass = glcore::RenderPass{&fbo2, first_pass_dim};
+                fbo2.clear_color({0.2f, 0.2, 0.2, 0.0f});
+                fbo2.clear_depth();
 
-            frame_buffer.bind();
-            frame_buffer.clear_color({0.4f, 0.4, 0.4, 0.0f});
-            frame_buffer.clear_depth();
+                print_error();
 
-            print_error();
+                shader.use();
+                shader.set_uniform_matrix4fv("mvp", projection *  model);
+                shader.set_uniform("height_map", utils::vec1i{0});
+                shader.set_uniform("diffuse_map", utils::vec1i{1});
+                height_texture.active_bind(0);
+                color_texture.active_bind(1);
+                vao.draw();
+            }
 
-            shader.use();
-            shader.set_uniform_matrix4fv("mvp", projection *  model);
-            shader.set_uniform("height_map", utils::vec1i{0});
-            shader.set_uniform("diffuse_map", utils::vec1i{1});
-            height_texture.active_bind(0);
-            color_texture.active_bind(1);
-            vao.draw();
-
-            shader2.use();
-            shader2.set_uniform("diffuse_map", utils::vec1i{0});
-            shader2.set_uniform_matrix4fv("mvp", projection * model);
-            //copy_texture.active_bind(0);
-            copy_depth_texture.active_bind(0);
-            plane_vao.draw();
+            //Second Pass
+            {
+                auto pass = glcore::RenderPass{nullptr, default_pass_dim};
+                frame_buffer.clear_color({0.4f, 0.4, 0.4, 0.0f});
+                frame_buffer.clear_depth();
+
+                print_error();
+
+                //The shader and textures of the first pass are still bound
+                shader.set_uniform_matrix4fv("mvp", projection *  model);
+                vao.draw();
+
+                shader2.use();
+                shader2.set_uniform("diffuse_map", utils::vec1i{0});
+                shader2.set_uniform_matrix4fv("mvp", projection * model);
+                //copy_texture.active_bind(0);
+                copy_depth_texture.active_bind(0);
+                plane_vao.draw();
+            }
 
         });
 
@@ -47,7 +47,7 @@ namespace nitros
 
         auto indexed_plane() const -> IndexedBuffers {
             auto vert = std::make_unique<glcore::Buffer>();
-            auto indi = std::make_unique<glcore::Buffer>();
+            auto indi = std::make_unique<glcore::Buffer>(glcore::Buffer::buffer_type::ELEMENT_BUFFER);
             auto cols = std::make_unique<glcore::Buffer>();
             auto norm = std::make_unique<glcore::Buffer>();
 
@@ -149,7 +149,7 @@ namespace nitros
             index_buffer.normals->write_data(normal);
             index_buffer.normals_data = std::move(normal);
 
-            index_buffer.indices  = std::make_unique<glcore::Buffer>();
+            index_buffer.indices  = std::make_unique<glcore::Buffer>(glcore::Buffer::buffer_type::ELEMENT_BUFFER);
             index_buffer.indices->write_data(index);
             index_buffer.indices_data = std::move(index);
 
@@ -175,7 +175,7 @@ namespace nitros
         // Gives color
         auto indexed_cube() const -> IndexedBuffers {
             auto vert = std::make_unique<glcore::Buffer>();
-            auto indi = std::make_unique<glcore::Buffer>();
+            auto indi = std::make_unique<glcore::Buffer>(glcore::Buffer::buffer_type::ELEMENT_BUFFER);
             auto cols = std::make_unique<glcore::Buffer>();
             auto norm = std::make_unique<glcore::Buffer>();
 
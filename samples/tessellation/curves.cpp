@@ -53,7 +53,7 @@ glcore::load_context(glfwGetProcAddress);
         
         auto curve =  std::make_shared<glcore::Buffer>();
         curve->write_data(curve_points);
-        auto index = std::make_shared<glcore::Buffer>();
+        auto index = std::make_shared<glcore::Buffer>(glcore::Buffer::buffer_type::ELEMENT_BUFFER);
         index->write_data(indices);
 
         print_error();
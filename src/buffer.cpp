@@ -1,10 +1,18 @@
 
 
 #include <glcore/buffer.hpp>
+#include "glcore/staging_buffer.hpp"
+#include "glcore/object_pool.hpp"
+#include "glcore/memory_tracker.hpp"
+#include "glcore/state_cache.hpp"
+#include "glcore/commands.hpp"
 #include "platform/gl.hpp"
+#include "logger.hpp"
 #include <type_traits>
 #include <cstring>
 #include <stdexcept>
+#include <algorithm>
+#include <optional>
 
 namespace nitros::glcore
 {
@@ -19,6 +27,94 @@ namespace nitros::glcore
         }
     }
 
+    constexpr auto get_GLUsage(Buffer::usage  usage_) {
+        switch(usage_)
+        {
+            case Buffer::usage::static_draw  : return GL_STATIC_DRAW;
+            case Buffer::usage::dynamic_draw : return GL_DYNAMIC_DRAW;
+            case Buffer::usage::stream_draw  : return GL_STREAM_DRAW;
+            case Buffer::usage::read_back    : return GL_STREAM_READ;
+
+            default:
+                return GL_STATIC_DRAW;
+        }
+    }
+
+#if !defined(OPENGL_CORE)
+    //Binds to the target of the role, the element binding belongs to the bound VertexArray and VertexArrays stay bound after their draws
+    auto bind_upload(Buffer::buffer_type  type, std::uint32_t  id) -> GLenum
+    {
+        if(type == Buffer::buffer_type::ELEMENT_BUFFER) {
+            StateCache::get_instance().bind_vertex_array(0);
+        }
+        const auto target = get_GLType(type);
+        glBindBuffer(target, id);
+        return target;
+    }
+#endif
+
+    //Streamed buffers keep orphaning their storage with glBufferData, immutable storage can't be reused for another size
+    auto is_pooled(Buffer::usage  usage_, bool immutable) -> bool {
+        return !immutable && usage_ != Buffer::usage::stream_draw && ObjectPool::get_instance().enabled();
+    }
+
+    //Element and array buffer objects stay apart, WebGL fixes the role of a buffer object on its first bind
+    auto get_poolKey(Buffer::usage  usage_, Buffer::buffer_type  type, std::size_t  size_class) -> pool::Key {
+        return pool::Key{ pool::kind::buffer, static_cast<std::uint32_t>(get_GLUsage(usage_)), static_cast<std::uint32_t>(get_GLType(type)), static_cast<std::uint32_t>(size_class), 1, 1 };
+    }
+
+#if OPENGL_CORE >= 40500
+    constexpr auto get_GLStorageFlags(Buffer::usage  usage_) -> GLbitfield {
+        switch(usage_)
+        {
+            case Buffer::usage::static_draw  : return 0;
+            case Buffer::usage::dynamic_draw : return GL_DYNAMIC_STORAGE_BIT;
+            case Buffer::usage::stream_draw  : return GL_DYNAMIC_STORAGE_BIT | GL_MAP_WRITE_BIT | GL_CLIENT_STORAGE_BIT;
+            case Buffer::usage::read_back    : return GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT;
+
+            default:
+                return 0;
+        }
+    }
+#endif
+
+#if defined(OPENGL_CORE)
+    struct ClearFormat
+    {
+        GLenum  internal_format;
+        GLenum  format;
+        GLenum  type;
+    };
+
+    //Formats usable by glClearBufferSubData, 8 and 16 bit three component rows have none
+    auto get_clearFormat(Buffer::value_type  type, std::size_t  components) -> std::optional<ClearFormat> {
+        auto pick = [components](std::array<GLenum, 4>  internal_formats, bool integer, GLenum gl_type) -> std::optional<ClearFormat> {
+            const auto formats = integer ? std::array<GLenum, 4>{ GL_RED_INTEGER, GL_RG_INTEGER, GL_RGB_INTEGER, GL_RGBA_INTEGER }
+                                         : std::array<GLenum, 4>{ GL_RED, GL_RG, GL_RGB, GL_RGBA };
+            if(components == 0 || components > 4 || internal_formats[components - 1] == GL_NONE) {
+                return std::nullopt;
+            }
+            return ClearFormat{ internal_formats[components - 1], formats[components - 1], gl_type };
+        };
+
+        switch(type)
+        {
+            case Buffer::value_type::FLOAT  : return pick({ GL_R32F, GL_RG32F, GL_RGB32F, GL_RGBA32F }, false, GL_FLOAT);
+            case Buffer::value_type::HALF   : return pick({ GL_R16F, GL_RG16F, GL_NONE, GL_RGBA16F }, false, GL_HALF_FLOAT);
+            case Buffer::value_type::UINT   : return pick({ GL_R32UI, GL_RG32UI, GL_RGB32UI, GL_RGBA32UI }, true, GL_UNSIGNED_INT);
+            case Buffer::value_type::INT    : return pick({ GL_R32I, GL_RG32I, GL_RGB32I, GL_RGBA32I }, true, GL_INT);
+            case Buffer::value_type::USHORT : return pick({ GL_R16UI, GL_RG16UI, GL_NONE, GL_RGBA16UI }, true, GL_UNSIGNED_SHORT);
+            case Buffer::value_type::SHORT  : return pick({ GL_R16I, GL_RG16I, GL_NONE, GL_RGBA16I }, true, GL_SHORT);
+            case Buffer::value_type::UBYTE  : return pick({ GL_R8UI, GL_RG8UI, GL_NONE, GL_RGBA8UI }, true, GL_UNSIGNED_BYTE);
+            case Buffer::value_type::BYTE   : return pick({ GL_R8I, GL_RG8I, GL_NONE, GL_RGBA8I }, true, GL_BYTE);
+            case Buffer::value_type::INT_2_10_10_10 : return ClearFormat{ GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT };
+
+            default:
+                return std::nullopt;
+        }
+    }
+#endif
+
     template<class type_>
     auto get_valueType();
 
@@ -32,8 +128,119 @@ namespace nitros::glcore
         return Buffer::value_type::UINT;
     }
 
-    Buffer::Buffer()
-        :_value_type{value_type::FLOAT}
+    namespace buffer
+    {
+        void StagedRanges::add(std::size_t  offset, gsl::span<const std::uint8_t>  data)
+        {
+            if(data.empty()) {
+                return;
+            }
+
+            auto begin = offset;
+            auto end   = offset + data.size_bytes();
+
+            auto first = _ranges.upper_bound(begin);
+            if(first != _ranges.begin()) {
+                auto prev = std::prev(first);
+                if(prev->first + prev->second.size() >= begin) {
+                    first = prev;
+                }
+            }
+            auto last = first;
+            while(last != _ranges.end() && last->first <= end) {
+                begin = std::min(begin, last->first);
+                end   = std::max(end, last->first + last->second.size());
+                ++last;
+            }
+
+            //A range starting at or before offset grows in place, resize keeps repeated appends amortized linear
+            if(first != last && first->first <= offset)
+            {
+                auto &bytes = first->second;
+                bytes.resize(end - begin);
+                for(auto it = std::next(first); it != last; ++it) {
+                    std::memcpy(bytes.data() + (it->first - begin), it->second.data(), it->second.size());
+                }
+                std::memcpy(bytes.data() + (offset - begin), data.data(), data.size_bytes());
+                _ranges.erase(std::next(first), last);
+                return;
+            }
+
+            auto merged = std::vector<std::uint8_t>(end - begin);
+            for(auto it = first; it != last; ++it) {
+                std::memcpy(merged.data() + (it->first - begin), it->second.data(), it->second.size());
+            }
+            std::memcpy(merged.data() + (offset - begin), data.data(), data.size_bytes());
+
+            _ranges.erase(first, last);
+            _ranges[begin] = std::move(merged);
+        }
+
+        void StagedRanges::erase(std::size_t  offset, std::size_t  size)
+        {
+            if(size == 0) {
+                return;
+            }
+            const auto end = offset + size;
+
+            auto it = _ranges.upper_bound(offset);
+            if(it != _ranges.begin()) {
+                auto prev = std::prev(it);
+                if(prev->first + prev->second.size() > offset) {
+                    it = prev;
+                }
+            }
+            while(it != _ranges.end() && it->first < end)
+            {
+                const auto range_begin = it->first;
+                const auto range_end   = it->first + it->second.size();
+                auto bytes = std::move(it->second);
+                it = _ranges.erase(it);
+
+                if(range_begin < offset) {
+                    _ranges.emplace(range_begin, std::vector<std::uint8_t>(bytes.begin(), bytes.begin() + (offset - range_begin)));
+                }
+                if(range_end > end) {
+                    it = _ranges.emplace(end, std::vector<std::uint8_t>(bytes.begin() + (end - range_begin), bytes.end())).first;
+                    ++it;
+                }
+            }
+        }
+
+        void StagedRanges::clear() noexcept
+        {
+            _ranges.clear();
+        }
+
+        auto StagedRanges::empty() const noexcept -> bool
+        {
+            return _ranges.empty();
+        }
+
+        auto StagedRanges::ranges() const noexcept -> const std::map<std::size_t, std::vector<std::uint8_t>>&
+        {
+            return _ranges;
+        }
+    }
+
+    Buffer::Buffer(usage  usage_, storage_policy  policy)
+        :Buffer{buffer_type::ARRAY_BUFFER, usage_, policy}
+    {}
+
+    Buffer::Buffer(buffer_type  type, usage  usage_, [[maybe_unused]] storage_policy  policy)
+        :num_elements{0}
+        ,vec_components{1}
+        ,stride{0}
+        ,_value_type{value_type::FLOAT}
+        ,_normalized{false}
+        ,_usage{usage_}
+        ,_type{type}
+    #if OPENGL_CORE >= 40500
+        ,_immutable{policy == storage_policy::immutable_store}
+    #else
+        ,_immutable{false}
+    #endif
+        ,_storage_size{0}
     {
     #if OPENGL_CORE >= 40500
         glCreateBuffers(1, &_id);
@@ -44,6 +251,10 @@ namespace nitros::glcore
 
     Buffer::~Buffer()
     {
+        if(!_immutable && _storage_size > 0 && ObjectPool::get_instance().release(get_poolKey(_usage, _type, _storage_size), _id, _storage_size)) {
+            return;
+        }
+        MemoryTracker::get_instance().erase(memory::resource::buffer, _id);
         glDeleteBuffers(1, &_id);
     }
 
@@ -52,18 +263,97 @@ namespace nitros::glcore
         glBindBuffer(get_GLType(type), _id);
     }
     
-    void Buffer::write_data(const gsl::span<const std::uint8_t>  data, bool is_integral)
+    void Buffer::write_data(const gsl::span<const std::uint8_t>  data)
     {
+        _staged.clear();
+
+        if(!_immutable)
+        {
+            if(is_pooled(_usage, _immutable)) {
+                write_pooled(data);
+                return;
+            }
+            _storage_size = 0;
+        }
+
     #if OPENGL_CORE >= 40500
-        glNamedBufferData(_id, data.size(), data.data(), GL_STATIC_DRAW);
+        if(_immutable)
+        {
+            const auto flags = get_GLStorageFlags(_usage);
+            const auto size  = gsl::narrow_cast<std::size_t>(data.size());
+            if(_storage_size == size && (flags & GL_DYNAMIC_STORAGE_BIT)) {
+                glNamedBufferSubData(_id, 0, data.size(), data.data());
+                return;
+            }
+            if(_storage_size > 0) {
+                MemoryTracker::get_instance().erase(memory::resource::buffer, _id);
+                glDeleteBuffers(1, &_id);
+                glCreateBuffers(1, &_id);
+            }
+            if(size > 0) {
+                glNamedBufferStorage(_id, data.size(), data.data(), flags);
+            }
+            _storage_size = size;
+        }
+        else
+            glNamedBufferData(_id, data.size(), data.data(), get_GLUsage(_usage));
+    #elif defined(OPENGL_CORE)
+        //Copy target keeps the element binding of a bound VertexArray untouched
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferData(GL_COPY_WRITE_BUFFER, data.size(), data.data(), get_GLUsage(_usage));
     #else
-        auto array_type = is_integral ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
-        glBindBuffer(array_type, _id);
-        glBufferData(array_type, data.size(), data.data(), GL_STATIC_DRAW);
+        const auto target = bind_upload(_type, _id);
+        glBufferData(target, data.size(), data.data(), get_GLUsage(_usage));
     #endif
+        MemoryTracker::get_instance().record(memory::resource::buffer, _id, _immutable ? _storage_size : gsl::narrow_cast<std::size_t>(data.size()));
     }
 
-    void Buffer::read_data(gsl::span<std::uint8_t>  vec, std::size_t  stride_, bool is_integral) const
+    void Buffer::write_pooled(const gsl::span<const std::uint8_t>  data)
+    {
+        auto& pool = ObjectPool::get_instance();
+        const auto size_class = ObjectPool::size_class(gsl::narrow_cast<std::size_t>(data.size()));
+
+        if(size_class != _storage_size)
+        {
+            if(auto id = pool.acquire(get_poolKey(_usage, _type, size_class)))
+            {
+                if(_storage_size == 0 || !pool.release(get_poolKey(_usage, _type, _storage_size), _id, _storage_size)) {
+                    MemoryTracker::get_instance().erase(memory::resource::buffer, _id);
+                    glDeleteBuffers(1, &_id);
+                }
+                _id = *id;
+            }
+            else if(size_class > 0)
+            {
+            #if OPENGL_CORE >= 40500
+                glNamedBufferData(_id, size_class, nullptr, get_GLUsage(_usage));
+            #elif defined(OPENGL_CORE)
+                glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+                glBufferData(GL_COPY_WRITE_BUFFER, size_class, nullptr, get_GLUsage(_usage));
+            #else
+                const auto target = bind_upload(_type, _id);
+                glBufferData(target, size_class, nullptr, get_GLUsage(_usage));
+            #endif
+            }
+            _storage_size = size_class;
+            MemoryTracker::get_instance().record(memory::resource::buffer, _id, size_class);
+        }
+
+        if(data.empty()) {
+            return;
+        }
+    #if OPENGL_CORE >= 40500
+        glNamedBufferSubData(_id, 0, data.size(), data.data());
+    #elif defined(OPENGL_CORE)
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, 0, data.size(), data.data());
+    #else
+        const auto target = bind_upload(_type, _id);
+        glBufferSubData(target, 0, data.size(), data.data());
+    #endif
+    }
+
+    void Buffer::read_data(gsl::span<std::uint8_t>  vec, std::size_t  stride_) const
     {
         if(stride_ != stride){
             throw std::runtime_error("Write Stride and Read Stride doesn't match");
@@ -73,20 +363,146 @@ namespace nitros::glcore
     #if OPENGL_CORE >= 40500
         glGetNamedBufferSubData(_id, 0, size, vec.data() );
     #elif OPENGL_CORE >= 40300
-        auto array_type = is_integral ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
-        glBindBuffer(array_type, _id);
-        glGetBufferSubData(array_type, 0, size, vec.data());
+        glBindBuffer(GL_COPY_READ_BUFFER, _id);
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, size, vec.data());
     #else
-        auto array_type = is_integral ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER;
-        glBindBuffer(array_type, _id);
-        void*  _map_data = glMapBufferRange(array_type, 0, size, GL_MAP_READ_BIT);
+        const auto target = bind_upload(_type, _id);
+        void*  _map_data = glMapBufferRange(target, 0, size, GL_MAP_READ_BIT);
         if(_map_data != nullptr){
             std::memcpy(vec.data(), _map_data, size);
         }
-        glUnmapBuffer(array_type);
+        glUnmapBuffer(target);
     #endif
     }
 
+    void Buffer::write_sub_data(std::size_t  byte_offset, const gsl::span<const std::uint8_t>  data, std::size_t  stride_)
+    {
+        if(stride_ != stride){
+            throw std::runtime_error("Write Stride and Sub Data Stride doesn't match");
+        }
+        if(byte_offset + data.size_bytes() > size_bytes()){
+            throw std::out_of_range("Sub Data exceeds the Buffer size");
+        }
+        check_client_writable();
+        //Older staged bytes mustn't overwrite this write on the next flush
+        _staged.erase(byte_offset, data.size_bytes());
+
+    #if OPENGL_CORE >= 40500
+        glNamedBufferSubData(_id, byte_offset, data.size_bytes(), data.data());
+    #else
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, byte_offset, data.size_bytes(), data.data());
+    #endif
+    }
+
+    void Buffer::stage_sub_data(std::size_t  byte_offset, const gsl::span<const std::uint8_t>  data, std::size_t  stride_)
+    {
+        if(stride_ != stride){
+            throw std::runtime_error("Write Stride and Sub Data Stride doesn't match");
+        }
+        if(byte_offset + data.size_bytes() > size_bytes()){
+            throw std::out_of_range("Sub Data exceeds the Buffer size");
+        }
+        check_client_writable();
+
+        _staged.add(byte_offset, data);
+    }
+
+    void Buffer::flush_staged()
+    {
+        if(_staged.empty()) {
+            return;
+        }
+
+    #if OPENGL_CORE < 40500
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+    #endif
+        for(auto &[offset, bytes] : _staged.ranges())
+        {
+        #if OPENGL_CORE >= 40500
+            glNamedBufferSubData(_id, offset, bytes.size(), bytes.data());
+        #else
+            glBufferSubData(GL_COPY_WRITE_BUFFER, offset, bytes.size(), bytes.data());
+        #endif
+        }
+        _staged.clear();
+    }
+
+    void Buffer::copy_from(const Buffer  &src, std::size_t  src_offset, std::size_t  dst_offset, std::size_t  size)
+    {
+        if(src_offset + size > src.size_bytes() || dst_offset + size > size_bytes()){
+            throw std::out_of_range("Copy range exceeds the Buffer size");
+        }
+        if(&src == this && src_offset < dst_offset + size && dst_offset < src_offset + size){
+            throw std::invalid_argument("Copy ranges inside one Buffer overlap");
+        }
+        if(size == 0) {
+            return;
+        }
+        _staged.erase(dst_offset, size);
+
+    #if OPENGL_CORE >= 40500
+        glCopyNamedBufferSubData(src.get_id(), _id, src_offset, dst_offset, size);
+    #else
+        glBindBuffer(GL_COPY_READ_BUFFER, src.get_id());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, src_offset, dst_offset, size);
+    #endif
+    }
+
+    void Buffer::clear_data(std::size_t  byte_offset, std::size_t  size, [[maybe_unused]] value_type  type, [[maybe_unused]] std::size_t  components, const gsl::span<const std::uint8_t>  value)
+    {
+        if(byte_offset + size > size_bytes()){
+            throw std::out_of_range("Clear range exceeds the Buffer size");
+        }
+        if(size == 0) {
+            return;
+        }
+        _staged.erase(byte_offset, size);
+
+    #if defined(OPENGL_CORE)
+        if(auto clear_format = get_clearFormat(type, components); clear_format)
+        {
+            auto [internal_format, format, gl_type] = *clear_format;
+        #if OPENGL_CORE >= 40500
+            glClearNamedBufferSubData(_id, internal_format, byte_offset, size, format, gl_type, value.data());
+        #elif defined(OPENGL_CORE)
+            glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+            glClearBufferSubData(GL_COPY_WRITE_BUFFER, internal_format, byte_offset, size, format, gl_type, value.data());
+        #endif
+            return;
+        }
+    #endif
+
+        //No matching clear format, upload the repeated value
+        check_client_writable();
+        const auto row_size = gsl::narrow_cast<std::size_t>( value.size_bytes() );
+        auto fill = std::vector<std::uint8_t>(size);
+        for(auto offset = std::size_t{0}; offset + row_size <= size; offset += row_size) {
+            std::memcpy(fill.data() + offset, value.data(), row_size);
+        }
+    #if OPENGL_CORE >= 40500
+        glNamedBufferSubData(_id, byte_offset, size, fill.data());
+    #else
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, byte_offset, size, fill.data());
+    #endif
+    }
+
+    void Buffer::check_client_writable() const
+    {
+    #if OPENGL_CORE >= 40500
+        if(_immutable && !(get_GLStorageFlags(_usage) & GL_DYNAMIC_STORAGE_BIT)) {
+            throw std::logic_error("Immutable Buffer without dynamic storage can't be updated from the client");
+        }
+    #endif
+    }
+
+    auto Buffer::has_staged() const noexcept -> bool
+    {
+        return !_staged.empty();
+    }
+
     const std::size_t Buffer::get_elements_count() const noexcept
     {
         return num_elements;
@@ -106,4 +522,170 @@ namespace nitros::glcore
     {
         return _value_type;
     }
-}
\ No newline at end of file
+
+    auto Buffer::is_normalized() const noexcept -> bool
+    {
+        return _normalized;
+    }
+
+    auto Buffer::is_integer_attribute() const noexcept -> bool
+    {
+        switch(_value_type)
+        {
+            case value_type::FLOAT :
+            case value_type::HALF  :
+            case value_type::INT_2_10_10_10 : return false;
+
+            default:
+                return !_normalized;
+        }
+    }
+
+    const std::size_t Buffer::size_bytes() const noexcept
+    {
+        return num_elements / vec_components * stride;
+    }
+
+    auto Buffer::get_usage() const noexcept -> usage
+    {
+        return _usage;
+    }
+
+    auto Buffer::is_immutable() const noexcept -> bool
+    {
+        return _immutable;
+    }
+
+    auto Buffer::get_buffer_type() const noexcept -> buffer_type
+    {
+        return _type;
+    }
+
+    namespace
+    {
+        constexpr auto align_up(std::size_t  value, std::size_t  alignment) -> std::size_t
+        {
+            return alignment > 1 ? ( (value + alignment - 1) / alignment ) * alignment : value;
+        }
+    }
+
+    StreamBuffer::StreamBuffer(std::size_t  frame_size, std::uint32_t  frames_in_flight)
+        :GLobj{}
+        ,_frame_size{frame_size}
+        ,_frames{frames_in_flight}
+        ,_frame_index{0}
+        ,_head{0}
+        ,_flushed{0}
+        ,_mapped_ptr{nullptr}
+        ,_client_copy{}
+        ,_fences(frames_in_flight)
+    {
+        if(frame_size == 0 || frames_in_flight == 0) {
+            throw std::invalid_argument("Stream Buffer size and frames must be Greater Than Zero");
+        }
+
+        const auto total_size = gsl::narrow_cast<GLsizeiptr>(_frame_size * _frames);
+
+    #if OPENGL_CORE >= 40500
+        const auto flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glCreateBuffers(1, &_id);
+        glNamedBufferStorage(_id, total_size, nullptr, flags);
+        _mapped_ptr = static_cast<std::uint8_t*>( glMapNamedBufferRange(_id, 0, total_size, flags) );
+
+        if(_mapped_ptr == nullptr) {
+            command::error();
+            glDeleteBuffers(1, &_id);
+            throw std::runtime_error("Stream Buffer Map error");
+        }
+    #else
+        glGenBuffers(1, &_id);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferData(GL_COPY_WRITE_BUFFER, total_size, nullptr, GL_STREAM_DRAW);
+        _client_copy.resize(_frame_size);
+    #endif
+        MemoryTracker::get_instance().record(memory::resource::staging, _id, total_size);
+    }
+
+    StreamBuffer::~StreamBuffer()
+    {
+    #if OPENGL_CORE >= 40500
+        glUnmapNamedBuffer(_id);
+    #endif
+        MemoryTracker::get_instance().erase(memory::resource::staging, _id);
+        glDeleteBuffers(1, &_id);
+    }
+
+    void StreamBuffer::bind(Buffer::buffer_type type) const
+    {
+        glBindBuffer(get_GLType(type), _id);
+    }
+
+    auto StreamBuffer::allocate(std::size_t  size, std::size_t  alignment) -> Allocation<std::uint8_t>
+    {
+        const auto base  = frame_offset();
+        const auto start = align_up(base + _head, alignment) - base;
+
+        if(start + size > _frame_size) {
+            LOG_W("Stream Buffer frame region exhausted, requested {} of {} bytes", size, _frame_size);
+            return { base + _head, {} };
+        }
+
+        _head = start + size;
+
+        auto data_ptr = _mapped_ptr ? _mapped_ptr + base + start : _client_copy.data() + start;
+        return { base + start, gsl::span<std::uint8_t>{ data_ptr, gsl::narrow_cast<std::ptrdiff_t>(size) } };
+    }
+
+    void StreamBuffer::flush()
+    {
+        if(_head <= _flushed) {
+            return;
+        }
+
+    #if OPENGL_CORE < 40500
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, frame_offset() + _flushed, _head - _flushed, _client_copy.data() + _flushed);
+    #endif
+        _flushed = _head;
+    }
+
+    void StreamBuffer::next_frame()
+    {
+        using namespace std::chrono_literals;
+
+        flush();
+        _fences[_frame_index] = std::make_unique<Fence>();
+
+        //The next region mustn't be handed out while the GPU may still read it, a stall this long means a lost context
+        const auto next = (_frame_index + 1) % _frames;
+        if(auto &fence = _fences[next]; fence) {
+            auto waited = 0s;
+            while(!fence->wait(1s)) {
+                if(++waited >= 10s) {
+                    throw std::runtime_error("Stream Buffer frame region still in use by the GPU");
+                }
+                LOG_W("Stream Buffer waiting {}s for the GPU to release the next frame region", waited.count());
+            }
+            fence.reset();
+        }
+
+        _frame_index = next;
+        _head    = 0;
+        _flushed = 0;
+    }
+
+    auto StreamBuffer::frame_size() const noexcept -> std::size_t
+    {
+        return _frame_size;
+    }
+
+    auto StreamBuffer::frame_offset() const noexcept -> std::size_t
+    {
+        return _frame_size * _frame_index;
+    }
+
+    auto StreamBuffer::frame_used() const noexcept -> std::size_t
+    {
+        return _head;
+    }
+}
@@ -0,0 +1,259 @@
+
+#include "glcore/buffer_heap.hpp"
+#include "glcore/commands.hpp"
+#include "glcore/memory_tracker.hpp"
+#include "platform/gl.hpp"
+#include "logger.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace nitros::glcore
+{
+    namespace
+    {
+        constexpr auto align_up(std::size_t  value, std::size_t  alignment) -> std::size_t
+        {
+            return alignment > 1 ? ( (value + alignment - 1) / alignment ) * alignment : value;
+        }
+
+        void copy_range(std::uint32_t  read_id, std::uint32_t  write_id, std::size_t  src_offset, std::size_t  dst_offset, std::size_t  size)
+        {
+        #if OPENGL_CORE >= 40500
+            glCopyNamedBufferSubData(read_id, write_id, src_offset, dst_offset, size);
+        #else
+            glBindBuffer(GL_COPY_READ_BUFFER, read_id);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, write_id);
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, src_offset, dst_offset, size);
+        #endif
+        }
+    }
+
+    BufferHeap::BufferHeap(std::size_t  capacity)
+        :GLobj{}
+        ,_capacity{capacity}
+        ,_used{0}
+        ,_next_key{0}
+        ,_free_blocks{}
+        ,_blocks{}
+    {
+        if(capacity == 0) {
+            throw std::invalid_argument("Buffer Heap capacity must be Greater Than Zero");
+        }
+
+    #if OPENGL_CORE >= 40500
+        glCreateBuffers(1, &_id);
+        glNamedBufferStorage(_id, gsl::narrow_cast<GLsizeiptr>(_capacity), nullptr, GL_DYNAMIC_STORAGE_BIT);
+    #else
+        glGenBuffers(1, &_id);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferData(GL_COPY_WRITE_BUFFER, gsl::narrow_cast<GLsizeiptr>(_capacity), nullptr, GL_STATIC_DRAW);
+    #endif
+        _free_blocks[0] = _capacity;
+        MemoryTracker::get_instance().record(memory::resource::buffer, _id, _capacity);
+    }
+
+    BufferHeap::~BufferHeap()
+    {
+        MemoryTracker::get_instance().erase(memory::resource::buffer, _id);
+        glDeleteBuffers(1, &_id);
+    }
+
+    void BufferHeap::bind(Buffer::buffer_type type) const
+    {
+        glBindBuffer(type == Buffer::buffer_type::ELEMENT_BUFFER ? GL_ELEMENT_ARRAY_BUFFER : GL_ARRAY_BUFFER, _id);
+    }
+
+    auto BufferHeap::allocate(std::size_t  size, std::size_t  alignment) -> std::optional<Handle>
+    {
+        if(size == 0) {
+            return std::nullopt;
+        }
+
+        for(auto it = _free_blocks.begin(); it != _free_blocks.end(); ++it)
+        {
+            const auto [block_offset, block_size] = *it;
+            const auto offset  = align_up(block_offset, alignment);
+            const auto padding = offset - block_offset;
+
+            if(padding + size > block_size) {
+                continue;
+            }
+
+            _free_blocks.erase(it);
+            if(padding > 0) {
+                _free_blocks[block_offset] = padding;
+            }
+            if(padding + size < block_size) {
+                _free_blocks[offset + size] = block_size - padding - size;
+            }
+
+            const auto key = _next_key++;
+            _blocks[key] = Block{ offset, size, alignment };
+            _used += size;
+            return Handle{ key };
+        }
+
+        LOG_W("Buffer Heap has no free block of {} bytes", size);
+        return std::nullopt;
+    }
+
+    void BufferHeap::free(const Handle  &handle)
+    {
+        auto it = _blocks.find(handle.key);
+        if(it == _blocks.end()) {
+            LOG_W("Buffer Heap free of an unknown handle");
+            return;
+        }
+
+        release(it->second.offset, it->second.size);
+        _used -= it->second.size;
+        _blocks.erase(it);
+    }
+
+    void BufferHeap::release(std::size_t  offset, std::size_t  size)
+    {
+        auto begin = offset;
+        auto end   = offset + size;
+
+        auto next = _free_blocks.lower_bound(begin);
+        if(next != _free_blocks.begin()) {
+            auto prev = std::prev(next);
+            if(prev->first + prev->second == begin) {
+                begin = prev->first;
+                _free_blocks.erase(prev);
+            }
+        }
+        if(next != _free_blocks.end() && next->first == end) {
+            end = next->first + next->second;
+            _free_blocks.erase(next);
+        }
+
+        _free_blocks[begin] = end - begin;
+    }
+
+    void BufferHeap::write(const Handle  &handle, const gsl::span<const std::uint8_t>  data, std::size_t  offset)
+    {
+        const auto range = get_range(handle);
+        if(offset + data.size_bytes() > range.size) {
+            throw std::out_of_range("Buffer Heap write exceeds the allocation");
+        }
+
+    #if OPENGL_CORE >= 40500
+        glNamedBufferSubData(_id, range.offset + offset, data.size_bytes(), data.data());
+    #else
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, range.offset + offset, data.size_bytes(), data.data());
+    #endif
+    }
+
+    auto BufferHeap::get_range(const Handle  &handle) const -> Range
+    {
+        auto it = _blocks.find(handle.key);
+        if(it == _blocks.end()) {
+            throw std::invalid_argument("Buffer Heap handle is not allocated");
+        }
+        return { it->second.offset, it->second.size };
+    }
+
+    void BufferHeap::copy(std::size_t  src_offset, std::size_t  dst_offset, std::size_t  size, std::uint32_t  scratch)
+    {
+        //Source and destination ranges of a copy inside one buffer must not overlap, overlapping moves go through scratch
+        if(src_offset - dst_offset >= size) {
+            copy_range(_id, _id, src_offset, dst_offset, size);
+        }
+        else {
+            copy_range(_id, scratch, src_offset, 0, size);
+            copy_range(scratch, _id, 0, dst_offset, size);
+        }
+    }
+
+    auto BufferHeap::defragment() -> std::size_t
+    {
+        auto order = std::vector<std::pair<std::size_t, std::uint32_t>>{};
+        order.reserve(_blocks.size());
+        for(auto &[key, block] : _blocks) {
+            order.emplace_back(block.offset, key);
+        }
+        std::sort(order.begin(), order.end());
+
+        //One scratch buffer for the moves shorter than their block, sized to the largest of them
+        auto scratch_size = std::size_t{0};
+        auto head  = std::size_t{0};
+        for(auto &[offset, key] : order)
+        {
+            const auto &block = _blocks[key];
+            const auto dst = align_up(head, block.alignment);
+            if(dst < block.offset && block.offset - dst < block.size) {
+                scratch_size = std::max(scratch_size, block.size);
+            }
+            head = std::min(dst, block.offset) + block.size;
+        }
+
+        auto scratch = std::uint32_t{0};
+        if(scratch_size > 0)
+        {
+        #if OPENGL_CORE >= 40500
+            glCreateBuffers(1, &scratch);
+            glNamedBufferStorage(scratch, gsl::narrow_cast<GLsizeiptr>(scratch_size), nullptr, 0);
+        #else
+            glGenBuffers(1, &scratch);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, scratch);
+            glBufferData(GL_COPY_WRITE_BUFFER, gsl::narrow_cast<GLsizeiptr>(scratch_size), nullptr, GL_STREAM_COPY);
+        #endif
+        }
+
+        auto moved = std::size_t{0};
+        head = 0;
+        for(auto &[offset, key] : order)
+        {
+            auto &block = _blocks[key];
+            const auto dst = align_up(head, block.alignment);
+            if(dst < block.offset) {
+                copy(block.offset, dst, block.size, scratch);
+                block.offset = dst;
+                ++moved;
+            }
+            head = block.offset + block.size;
+        }
+
+        if(scratch != 0) {
+            glDeleteBuffers(1, &scratch);
+        }
+
+        _free_blocks.clear();
+        auto gap_start = std::size_t{0};
+        for(auto &[offset, key] : order)
+        {
+            auto &block = _blocks[key];
+            if(block.offset > gap_start) {
+                _free_blocks[gap_start] = block.offset - gap_start;
+            }
+            gap_start = block.offset + block.size;
+        }
+        if(gap_start < _capacity) {
+            _free_blocks[gap_start] = _capacity - gap_start;
+        }
+
+        command::error();
+        return moved;
+    }
+
+    auto BufferHeap::capacity() const noexcept -> std::size_t
+    {
+        return _capacity;
+    }
+
+    auto BufferHeap::used() const noexcept -> std::size_t
+    {
+        return _used;
+    }
+
+    auto BufferHeap::largest_free_block() const noexcept -> std::size_t
+    {
+        auto largest = std::size_t{0};
+        for(auto &[offset, size] : _free_blocks) {
+            largest = std::max(largest, size);
+        }
+        return largest;
+    }
+} // namespace nitros::glcore
@@ -0,0 +1,306 @@
+
+
+#include "glcore/command_list.hpp"
+#include "glcore/state_cache.hpp"
+#include "utils/gl_conversions.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace nitros::glcore
+{
+    namespace
+    {
+        enum op : std::uint8_t
+        {
+            bind_framebuffer,
+            clear_color,
+            clear_depth,
+            use_shader,
+            uniform_float,
+            uniform_int,
+            uniform_matrix,
+            bind_texture,
+            set_capability,
+            draw,
+            draw_index_count,
+            draw_range
+        };
+
+        struct Header
+        {
+            std::uint8_t    code;
+            std::uint8_t    padding;
+            std::uint16_t   name_length;
+            std::uint32_t   payload_size;
+        };
+
+        struct FrameBufferCmd   { const FrameBuffer* framebuffer; };
+        struct ClearColorCmd    { FrameBuffer* framebuffer; utils::vec4f color; };
+        struct ClearDepthCmd    { FrameBuffer* framebuffer; float depth; };
+        struct ShaderCmd        { Shader* shader; };
+        struct UniformFloatCmd  { std::uint32_t components; std::array<float, 4> value; };
+        struct UniformIntCmd    { std::uint32_t components; std::array<std::int32_t, 4> value; };
+        struct UniformMatrixCmd { glm::mat4 value; bool transpose; };
+        struct TextureCmd       { render::TextureBinding binding; };
+        struct CapabilityCmd    { Rasterizer::capability type; bool enable; };
+        struct DrawCmd          { const VertexArray* vertex_array; std::uint32_t instance_count; };
+        struct DrawIndexCmd     { const VertexArray* vertex_array; std::uint32_t index_offset; std::uint32_t index_count; };
+        struct DrawRangeCmd     { const VertexArray* vertex_array; vertex::MeshRange range; std::uint32_t instance_count; std::uint32_t base_instance; };
+
+        constexpr auto arena_alignment = std::size_t{8};
+
+        template <class payload_type>
+        auto read(const std::uint8_t*  data) -> payload_type
+        {
+            auto payload = payload_type{};
+            std::memcpy(&payload, data, sizeof(payload_type));
+            return payload;
+        }
+
+        void bind_texture_unit(const render::TextureBinding  &binding)
+        {
+            StateCache::get_instance().bind_texture_unit(binding.unit, to_glType(binding.target), binding.id);
+        }
+    }
+
+    CommandList::CommandList(std::size_t  reserve_bytes)
+    {
+        _arena.reserve(reserve_bytes);
+    }
+
+    template <class payload_type>
+    void CommandList::record(std::uint8_t  code, const payload_type  &payload, const std::string  &name)
+    {
+        static_assert(std::is_trivially_copyable_v<payload_type>);
+
+        const auto header = Header{ code, 0, gsl::narrow<std::uint16_t>(name.size()), static_cast<std::uint32_t>(sizeof(payload_type)) };
+        const auto size   = sizeof(Header) + sizeof(payload_type) + name.size();
+        const auto offset = _arena.size();
+
+        _arena.resize(offset + ( (size + arena_alignment - 1) / arena_alignment ) * arena_alignment);
+        auto data = _arena.data() + offset;
+        std::memcpy(data, &header, sizeof(Header));
+        std::memcpy(data + sizeof(Header), &payload, sizeof(payload_type));
+        if(!name.empty()) {
+            std::memcpy(data + sizeof(Header) + sizeof(payload_type), name.data(), name.size());
+        }
+        _commands++;
+    }
+
+    template <class type, std::size_t N>
+    void CommandList::record_uniform(const std::string  &name, const std::array<type, N>  &value)
+    {
+        if(!_has_shader) {
+            throw std::logic_error("Uniform recorded before use_shader");
+        }
+        if constexpr(std::is_same_v<type, float>) {
+            auto cmd = UniformFloatCmd{ N, {} };
+            std::copy(value.begin(), value.end(), cmd.value.begin());
+            record(op::uniform_float, cmd, name);
+        }
+        else {
+            auto cmd = UniformIntCmd{ N, {} };
+            std::copy(value.begin(), value.end(), cmd.value.begin());
+            record(op::uniform_int, cmd, name);
+        }
+    }
+
+    void CommandList::bind_framebuffer(const FrameBuffer*  framebuffer)
+    {
+        record(op::bind_framebuffer, FrameBufferCmd{framebuffer});
+    }
+
+    void CommandList::clear_color(FrameBuffer  &framebuffer, const utils::vec4f  &color)
+    {
+        record(op::clear_color, ClearColorCmd{&framebuffer, color});
+    }
+
+    void CommandList::clear_depth(FrameBuffer  &framebuffer, float  depth)
+    {
+        record(op::clear_depth, ClearDepthCmd{&framebuffer, depth});
+    }
+
+    void CommandList::use_shader(Shader  &shader)
+    {
+        record(op::use_shader, ShaderCmd{&shader});
+        _has_shader = true;
+    }
+
+    void CommandList::set_uniform(const std::string  &name, const std::array<float, 1>  &value) { record_uniform(name, value); }
+    void CommandList::set_uniform(const std::string  &name, const std::array<float, 2>  &value) { record_uniform(name, value); }
+    void CommandList::set_uniform(const std::string  &name, const std::array<float, 3>  &value) { record_uniform(name, value); }
+    void CommandList::set_uniform(const std::string  &name, const std::array<float, 4>  &value) { record_uniform(name, value); }
+    void CommandList::set_uniform(const std::string  &name, const std::array<std::int32_t, 1>  &value) { record_uniform(name, value); }
+    void CommandList::set_uniform(const std::string  &name, const std::array<std::int32_t, 2>  &value) { record_uniform(name, value); }
+    void CommandList::set_uniform(const std::string  &name, const std::array<std::int32_t, 3>  &value) { record_uniform(name, value); }
+    void CommandList::set_uniform(const std::string  &name, const std::array<std::int32_t, 4>  &value) { record_uniform(name, value); }
+
+    void CommandList::set_uniform_matrix4fv(const std::string  &name, const glm::mat4  &mat, bool transpose)
+    {
+        if(!_has_shader) {
+            throw std::logic_error("Uniform recorded before use_shader");
+        }
+        record(op::uniform_matrix, UniformMatrixCmd{mat, transpose}, name);
+    }
+
+    void CommandList::bind_texture(const render::TextureBinding  &binding)
+    {
+        record(op::bind_texture, TextureCmd{binding});
+    }
+
+    void CommandList::set_capability(Rasterizer::capability  type, bool enable)
+    {
+        record(op::set_capability, CapabilityCmd{type, enable});
+    }
+
+    void CommandList::draw(const VertexArray  &vertex_array, std::uint32_t  instance_count)
+    {
+        record(op::draw, DrawCmd{&vertex_array, instance_count});
+    }
+
+    void CommandList::draw_index_count(const VertexArray  &vertex_array, std::uint32_t  index_offset, std::uint32_t  index_count)
+    {
+        record(op::draw_index_count, DrawIndexCmd{&vertex_array, index_offset, index_count});
+    }
+
+    void CommandList::draw_range(const VertexArray  &vertex_array, const vertex::MeshRange  &range, std::uint32_t  instance_count, std::uint32_t  base_instance)
+    {
+        record(op::draw_range, DrawRangeCmd{&vertex_array, range, instance_count, base_instance});
+    }
+
+    void CommandList::append(const CommandList  &other)
+    {
+        _arena.insert(_arena.end(), other._arena.begin(), other._arena.end());
+        _commands   += other._commands;
+        _has_shader = _has_shader || other._has_shader;
+    }
+
+    void CommandList::execute() const
+    {
+        Shader* shader = nullptr;
+        auto& rasterizer = Rasterizer::get_instance();
+
+        auto offset = std::size_t{0};
+        while(offset < _arena.size())
+        {
+            const auto data    = _arena.data() + offset;
+            const auto header  = read<Header>(data);
+            const auto payload = data + sizeof(Header);
+            const auto name    = std::string{ reinterpret_cast<const char*>(payload + header.payload_size), header.name_length };
+
+            switch (header.code)
+            {
+                case op::bind_framebuffer: {
+                    auto cmd = read<FrameBufferCmd>(payload);
+                    if(cmd.framebuffer)
+                        cmd.framebuffer->bind();
+                    else
+                        FrameBuffer::bind_default();
+                    break;
+                }
+                case op::clear_color: {
+                    auto cmd = read<ClearColorCmd>(payload);
+                    cmd.framebuffer->clear_color(cmd.color);
+                    break;
+                }
+                case op::clear_depth: {
+                    auto cmd = read<ClearDepthCmd>(payload);
+                    cmd.framebuffer->clear_depth(cmd.depth);
+                    break;
+                }
+                case op::use_shader: {
+                    shader = read<ShaderCmd>(payload).shader;
+                    shader->use();
+                    break;
+                }
+                case op::uniform_float: {
+                    auto cmd = read<UniformFloatCmd>(payload);
+                    auto &v  = cmd.value;
+                    switch (cmd.components)
+                    {
+                        case 1: shader->set_uniform(name, utils::vec1f{v[0]}); break;
+                        case 2: shader->set_uniform(name, utils::vec2f{v[0], v[1]}); break;
+                        case 3: shader->set_uniform(name, utils::vec3f{v[0], v[1], v[2]}); break;
+                        default: shader->set_uniform(name, utils::vec4f{v[0], v[1], v[2], v[3]}); break;
+                    }
+                    break;
+                }
+                case op::uniform_int: {
+                    auto cmd = read<UniformIntCmd>(payload);
+                    auto &v  = cmd.value;
+                    switch (cmd.components)
+                    {
+                        case 1: shader->set_uniform(name, utils::vec1i{v[0]}); break;
+                        case 2: shader->set_uniform(name, utils::vec2i{v[0], v[1]}); break;
+                        case 3: shader->set_uniform(name, utils::vec3i{v[0], v[1], v[2]}); break;
+                        default: shader->set_uniform(name, utils::vec4i{v[0], v[1], v[2], v[3]}); break;
+                    }
+                    break;
+                }
+                case op::uniform_matrix: {
+                    auto cmd = read<UniformMatrixCmd>(payload);
+                    shader->set_uniform_matrix4fv(name, cmd.value, cmd.transpose);
+                    break;
+                }
+                case op::bind_texture: {
+                    bind_texture_unit(read<TextureCmd>(payload).binding);
+                    break;
+                }
+                case op::set_capability: {
+                    auto cmd = read<CapabilityCmd>(payload);
+                    if(cmd.enable)
+                        rasterizer.enable(cmd.type);
+                    else
+                        rasterizer.disable(cmd.type);
+                    break;
+                }
+                case op::draw: {
+                    auto cmd = read<DrawCmd>(payload);
+                    if(cmd.instance_count == 1)
+                        cmd.vertex_array->draw();
+                    else
+                        cmd.vertex_array->draw_instanced(cmd.instance_count);
+                    break;
+                }
+                case op::draw_index_count: {
+                    auto cmd = read<DrawIndexCmd>(payload);
+                    cmd.vertex_array->draw_index_count(cmd.index_offset, cmd.index_count);
+                    break;
+                }
+                case op::draw_range: {
+                    auto cmd = read<DrawRangeCmd>(payload);
+                    cmd.vertex_array->draw_range_instanced(cmd.range, cmd.instance_count, cmd.base_instance);
+                    break;
+                }
+                default:
+                    throw std::runtime_error("Command List holds an unknown command");
+            }
+
+            const auto size = sizeof(Header) + header.payload_size + header.name_length;
+            offset += ( (size + arena_alignment - 1) / arena_alignment ) * arena_alignment;
+        }
+    }
+
+    void CommandList::reset() noexcept
+    {
+        _arena.clear();
+        _commands   = 0;
+        _has_shader = false;
+    }
+
+    auto CommandList::command_count() const noexcept -> std::size_t
+    {
+        return _commands;
+    }
+
+    auto CommandList::size_bytes() const noexcept -> std::size_t
+    {
+        return _arena.size();
+    }
+
+    auto CommandList::empty() const noexcept -> bool
+    {
+        return _commands == 0;
+    }
+}
@@ -1,13 +1,14 @@
 
 
 #include "glcore/common_processing.hpp"
+#include "glcore/state_cache.hpp"
 #include "platform/gl.hpp"
 
 namespace nitros::glcore
 {
     void ViewPort::dimension(const ViewDim  &view_dim)
     {
-        glViewport( 
+        StateCache::get_instance().viewport(
             gsl::narrow_cast<std::int32_t>(view_dim.left_bottom[0]), 
             gsl::narrow_cast<std::int32_t>(view_dim.left_bottom[1]), 
             gsl::narrow_cast<std::int32_t>(view_dim.dimension[0]), 
@@ -16,8 +17,7 @@ namespace nitros::glcore
 
     auto ViewPort::dimension() -> ViewDim
     {
-        auto dim = utils::vec4i{};
-        glGetIntegerv(GL_VIEWPORT, dim.data());
+        const auto dim = StateCache::get_instance().get_viewport();
         
         auto view_dim = ViewDim{};
         view_dim.left_bottom = { gsl::narrow_cast<std::uint32_t>(dim[0]) , gsl::narrow_cast<std::uint32_t>(dim[1]) };
@@ -29,7 +29,7 @@ namespace nitros::glcore
 
     void Scissor::sissor(const ViewDim  &view_dim)
     {
-        glScissor(
+        StateCache::get_instance().scissor(
             gsl::narrow_cast<std::int32_t>(view_dim.left_bottom[0]), 
             gsl::narrow_cast<std::int32_t>(view_dim.left_bottom[1]), 
             gsl::narrow_cast<std::int32_t>(view_dim.dimension[0]), 
@@ -38,8 +38,7 @@ namespace nitros::glcore
 
     auto Scissor::dimension() -> ViewDim
     {
-        auto dim = utils::vec4i{};
-        glGetIntegerv(GL_SCISSOR_BOX, dim.data());
+        const auto dim = StateCache::get_instance().get_scissor();
 
         auto view_dim = ViewDim{};
         view_dim.left_bottom = { gsl::narrow_cast<std::uint32_t>(dim[0]) , gsl::narrow_cast<std::uint32_t>(dim[1]) };
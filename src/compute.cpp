@@ -0,0 +1,187 @@
+
+
+#include "glcore/compute.hpp"
+#include "platform/gl.hpp"
+#include "logger.hpp"
+#include <stdexcept>
+
+namespace nitros::glcore
+{
+    namespace
+    {
+        auto compute_stages(const std::string  &compute_pgm) -> shader::Stages
+        {
+        #if !defined(OPENGL_CORE)
+            throw std::runtime_error("Compute Programs need OpenGL 4.3");
+        #endif
+            auto stages = shader::Stages{};
+            stages.compute = compute_pgm;
+            return stages;
+        }
+
+    #if defined(OPENGL_CORE)
+        auto to_glAccess(compute::access  access) -> GLenum
+        {
+            switch(access)
+            {
+                case compute::access::read_only:   return GL_READ_ONLY;
+                case compute::access::write_only:  return GL_WRITE_ONLY;
+                case compute::access::read_write:  return GL_READ_WRITE;
+            }
+            return GL_READ_WRITE;
+        }
+
+        auto to_glFormat(compute::image_format  format) -> GLenum
+        {
+            switch(format)
+            {
+                case compute::image_format::r32f:      return GL_R32F;
+                case compute::image_format::rg32f:     return GL_RG32F;
+                case compute::image_format::rgba32f:   return GL_RGBA32F;
+                case compute::image_format::rgba16f:   return GL_RGBA16F;
+                case compute::image_format::rgba8:     return GL_RGBA8;
+                case compute::image_format::r32i:      return GL_R32I;
+                case compute::image_format::r32ui:     return GL_R32UI;
+                case compute::image_format::rgba32i:   return GL_RGBA32I;
+                case compute::image_format::rgba32ui:  return GL_RGBA32UI;
+            }
+            return GL_RGBA8;
+        }
+
+        auto to_glBarrier(compute::barrier  barriers) -> GLbitfield
+        {
+            using compute::barrier;
+            if(barriers == barrier::ALL) {
+                return GL_ALL_BARRIER_BITS;
+            }
+            auto bits = GLbitfield{0};
+            if(has_flag(barriers, barrier::SHADER_STORAGE))       bits |= GL_SHADER_STORAGE_BARRIER_BIT;
+            if(has_flag(barriers, barrier::SHADER_IMAGE_ACCESS))  bits |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+            if(has_flag(barriers, barrier::TEXTURE_FETCH))        bits |= GL_TEXTURE_FETCH_BARRIER_BIT;
+            if(has_flag(barriers, barrier::VERTEX_ATTRIB))        bits |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+            if(has_flag(barriers, barrier::ELEMENT_ARRAY))        bits |= GL_ELEMENT_ARRAY_BARRIER_BIT;
+            if(has_flag(barriers, barrier::COMMAND))              bits |= GL_COMMAND_BARRIER_BIT;
+            if(has_flag(barriers, barrier::BUFFER_UPDATE))        bits |= GL_BUFFER_UPDATE_BARRIER_BIT;
+            if(has_flag(barriers, barrier::FRAMEBUFFER))          bits |= GL_FRAMEBUFFER_BARRIER_BIT;
+            return bits;
+        }
+    #endif
+    }
+
+    ComputeProgram::ComputeProgram(const std::string  &compute_pgm)
+        :_shader{compute_stages(compute_pgm)}
+        ,_work_group_size{1, 1, 1}
+    {
+    #if defined(OPENGL_CORE)
+        auto linked = GLint{GL_FALSE};
+        glGetProgramiv(_shader.get_program(), GL_LINK_STATUS, &linked);
+        if(linked == GL_FALSE) {
+            throw std::runtime_error("Compute Program failed to link");
+        }
+
+        auto size = std::array<GLint, 3>{};
+        glGetProgramiv(_shader.get_program(), GL_COMPUTE_WORK_GROUP_SIZE, size.data());
+        for(auto i = std::size_t{0}; i < 3; i++) {
+            _work_group_size[i] = static_cast<std::uint32_t>(size[i]);
+        }
+    #endif
+    }
+
+    void ComputeProgram::use() const
+    {
+        _shader.use();
+    }
+
+    void ComputeProgram::dispatch(const compute::WorkGroups  &groups) const
+    {
+        if(groups.x == 0 || groups.y == 0 || groups.z == 0) {
+            return;
+        }
+        use();
+    #if defined(OPENGL_CORE)
+        glDispatchCompute(groups.x, groups.y, groups.z);
+    #endif
+    }
+
+    void ComputeProgram::dispatch_invocations(const compute::WorkGroups  &count) const
+    {
+        const auto groups = [](std::uint32_t  n, std::uint32_t  size) {
+            return n / size + (n % size != 0 ? 1u : 0u);
+        };
+        dispatch({ groups(count.x, _work_group_size[0]), groups(count.y, _work_group_size[1]), groups(count.z, _work_group_size[2]) });
+    }
+
+    void ComputeProgram::dispatch_indirect(const Buffer  &buffer, std::size_t  offset) const
+    {
+        if(offset % sizeof(std::uint32_t) != 0) {
+            throw std::invalid_argument("Dispatch Indirect offset must be a multiple of 4");
+        }
+        if(offset + sizeof(compute::DispatchIndirectCommand) > buffer.size_bytes()) {
+            throw std::out_of_range("Dispatch Indirect Command exceeds the Buffer size");
+        }
+        use();
+    #if defined(OPENGL_CORE)
+        glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, buffer.get_id());
+        glDispatchComputeIndirect(static_cast<GLintptr>(offset));
+    #endif
+    }
+
+    void ComputeProgram::bind_storage([[maybe_unused]] compute::StorageBinding  binding, [[maybe_unused]] const Buffer  &buffer)
+    {
+    #if defined(OPENGL_CORE)
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding.index, buffer.get_id());
+    #endif
+    }
+
+    void ComputeProgram::bind_storage([[maybe_unused]] compute::StorageBinding  binding, const Buffer  &buffer, std::size_t  offset, std::size_t  size)
+    {
+        if(offset + size > buffer.size_bytes()) {
+            throw std::out_of_range("Storage range exceeds the Buffer size");
+        }
+    #if defined(OPENGL_CORE)
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, binding.index, buffer.get_id(), static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+    #endif
+    }
+
+    void ComputeProgram::bind_image([[maybe_unused]] compute::ImageUnit  unit, const ColorTexture  &texture, std::uint32_t  level, [[maybe_unused]] compute::access  access,
+                                    [[maybe_unused]] compute::image_format  format, std::optional<std::uint32_t>  layer)
+    {
+        if(level >= texture.current_mip_levels()) {
+            throw std::out_of_range("Image level exceeds the Texture mip levels");
+        }
+        if(layer && texture.get_target() != texture::target::cube_map) {
+            LOG_W("Image layer {} ignored for a 2D Texture", *layer);
+            layer.reset();
+        }
+    #if defined(OPENGL_CORE)
+        const auto layered = texture.get_target() == texture::target::cube_map && !layer;
+        glBindImageTexture(unit.index, texture.get_id(), static_cast<GLint>(level), layered ? GL_TRUE : GL_FALSE,
+                           static_cast<GLint>(layer.value_or(0)), to_glAccess(access), to_glFormat(format));
+    #endif
+    }
+
+    void ComputeProgram::memory_barrier(compute::barrier  barriers)
+    {
+        if(barriers == compute::barrier::NONE) {
+            return;
+        }
+    #if defined(OPENGL_CORE)
+        glMemoryBarrier(to_glBarrier(barriers));
+    #endif
+    }
+
+    auto ComputeProgram::work_group_size() const noexcept -> const std::array<std::uint32_t, 3>&
+    {
+        return _work_group_size;
+    }
+
+    auto ComputeProgram::get_shader() noexcept -> Shader&
+    {
+        return _shader;
+    }
+
+    auto ComputeProgram::get_program() const -> std::uint32_t
+    {
+        return _shader.get_program();
+    }
+}
@@ -4,7 +4,10 @@
 #include "platform/gl.hpp"
 #include "utils/gl_conversions.hpp"
 #include "glcore/commands.hpp"
+#include "glcore/state_cache.hpp"
+#include "glcore/object_pool.hpp"
 #include <stdexcept>
+#include <vector>
 
 namespace nitros::glcore
 {
@@ -68,7 +71,7 @@ namespace nitros::glcore
             {
                 error_switch(error_id);
                 command::error();
-                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+                StateCache::get_instance().bind_framebuffer(GL_FRAMEBUFFER, 0);
                 throw std::runtime_error("Frame Buffer is not complete");
             }
         }
@@ -102,6 +105,57 @@ namespace nitros::glcore
         #endif
         }
 
+        //Attachment points in the order the constructor attaches them
+        auto attachment_points(const framebuffer::Attachment  &attachment) -> std::vector<std::uint32_t>
+        {
+            auto points = std::vector<std::uint32_t>{};
+            for(auto i = std::size_t{0}; i < attachment.color_views.size(); i++) {
+                points.push_back(GL_COLOR_ATTACHMENT0 + gsl::narrow_cast<std::uint32_t>(i));
+            }
+            if(attachment.depth_view) {
+                points.push_back(std::holds_alternative<framebuffer::Attachment::View<texture::type::depth>>(*attachment.depth_view) ? GL_DEPTH_ATTACHMENT : GL_DEPTH_STENCIL_ATTACHMENT);
+            }
+            if(attachment.stencil_view) {
+                points.push_back(GL_STENCIL_ATTACHMENT);
+            }
+            return points;
+        }
+
+        //FrameBuffers attaching the same points are interchangeable, every point is attached again on reuse
+        auto get_poolKey(const framebuffer::Attachment  &attachment) -> pool::Key
+        {
+            auto points = std::uint32_t{0};
+            for(auto point : attachment_points(attachment))
+            {
+                switch(point)
+                {
+                    case GL_DEPTH_ATTACHMENT:           points |= 1u; break;
+                    case GL_DEPTH_STENCIL_ATTACHMENT:   points |= 2u; break;
+                    case GL_STENCIL_ATTACHMENT:         points |= 4u; break;
+                    default: break;
+                }
+            }
+            return pool::Key{ pool::kind::framebuffer, gsl::narrow_cast<std::uint32_t>(attachment.color_views.size()), points, 0, 0, 0 };
+        }
+
+        //A pooled FrameBuffer mustn't keep the images of its attachments alive
+        void detach(std::uint32_t  id, const framebuffer::Attachment  &attachment)
+        {
+        #if OPENGL_CORE >= 40500
+            for(auto point : attachment_points(attachment)) {
+                glNamedFramebufferRenderbuffer(id, point, GL_RENDERBUFFER, 0);
+            }
+        #else
+            auto &cache = StateCache::get_instance();
+            const auto previous = cache.get_framebuffer(GL_DRAW_FRAMEBUFFER);
+            cache.bind_framebuffer(GL_DRAW_FRAMEBUFFER, id);
+            for(auto point : attachment_points(attachment)) {
+                glFramebufferRenderbuffer(GL_DRAW_FRAMEBUFFER, point, GL_RENDERBUFFER, 0);
+            }
+            cache.bind_framebuffer(GL_DRAW_FRAMEBUFFER, previous);
+        #endif
+        }
+
         template <texture::type T>
         auto attach_renderbuffer(const std::uint32_t  &id, std::uint32_t  attachment, const RenderBuffer<T>  &data)
         {
@@ -118,11 +172,18 @@ namespace nitros::glcore
         ,_mode{bind_mode::both}
     {
         auto& attachment = _attachment;
-    #if OPENGL_CORE >= 40500
-        glCreateFramebuffers(1, &_id);
-    #else
-        glGenFramebuffers(1, &_id);
-        glBindFramebuffer(GL_FRAMEBUFFER, _id);
+        if(auto pooled_id = ObjectPool::get_instance().acquire(get_poolKey(*attachment))) {
+            _id = *pooled_id;
+        }
+        else {
+        #if OPENGL_CORE >= 40500
+            glCreateFramebuffers(1, &_id);
+        #else
+            glGenFramebuffers(1, &_id);
+        #endif
+        }
+    #if OPENGL_CORE < 40500
+        StateCache::get_instance().bind_framebuffer(GL_FRAMEBUFFER, _id);
     #endif
 
         auto color_count = 0;
@@ -253,25 +314,35 @@ namespace nitros::glcore
         :_mode{bind_mode::both}
     {    
         _id = id;
-        glBindFramebuffer(GL_FRAMEBUFFER, _id);
+        StateCache::get_instance().bind_framebuffer(GL_FRAMEBUFFER, _id);
     }
 
     FrameBuffer::~FrameBuffer(){
-        if(_id != 0)
+        //The default FrameBuffer and moved from FrameBuffers have no attachment
+        if(_id != 0 && _attachment)
+        {
+            detach(_id, *_attachment);
+            if(ObjectPool::get_instance().release(get_poolKey(*_attachment), _id, ObjectPool::framebuffer_bytes)) {
+                return;
+            }
+        }
+        if(_id != 0) {
+            StateCache::get_instance().forget_framebuffer(_id);
             glDeleteFramebuffers(1, &_id);
+        }
     }
 
     void FrameBuffer::bind(bind_mode  mode) const noexcept{
         _mode = mode;
         switch (mode)
         {
-            case bind_mode::read: glBindFramebuffer(GL_READ_FRAMEBUFFER, _id);
+            case bind_mode::read: StateCache::get_instance().bind_framebuffer(GL_READ_FRAMEBUFFER, _id);
                                     break;
-            case bind_mode::draw: glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _id);
+            case bind_mode::draw: StateCache::get_instance().bind_framebuffer(GL_DRAW_FRAMEBUFFER, _id);
                                     break;
-            case bind_mode::both: glBindFramebuffer(GL_FRAMEBUFFER, _id);
+            case bind_mode::both: StateCache::get_instance().bind_framebuffer(GL_FRAMEBUFFER, _id);
                                     break;
-            default: glBindFramebuffer(GL_FRAMEBUFFER, _id);
+            default: StateCache::get_instance().bind_framebuffer(GL_FRAMEBUFFER, _id);
                         break;
         }
     }
@@ -620,6 +691,6 @@ namespace nitros::glcore
     }
 
     void FrameBuffer::bind_default() noexcept{
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            StateCache::get_instance().bind_framebuffer(GL_FRAMEBUFFER, 0);
     }
 }
\ No newline at end of file
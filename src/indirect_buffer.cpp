@@ -0,0 +1,159 @@
+
+
+#include "glcore/indirect_buffer.hpp"
+#include "glcore/memory_tracker.hpp"
+#include "platform/gl.hpp"
+#include "logger.hpp"
+#include <stdexcept>
+#include <algorithm>
+
+namespace nitros::glcore
+{
+    IndirectCommandBuffer::IndirectCommandBuffer(command_type  type)
+        :GLobj{}
+        ,_type{type}
+        ,_elements{}
+        ,_arrays{}
+        ,_capacity{0}
+        ,_dirty{false}
+    {
+    #if OPENGL_CORE >= 40500
+        glCreateBuffers(1, &_id);
+    #elif defined(OPENGL_CORE)
+        glGenBuffers(1, &_id);
+    #else
+        _id = 0;
+    #endif
+    }
+
+    IndirectCommandBuffer::~IndirectCommandBuffer()
+    {
+    #if defined(OPENGL_CORE)
+        MemoryTracker::get_instance().erase(memory::resource::buffer, _id);
+        glDeleteBuffers(1, &_id);
+    #endif
+    }
+
+    void IndirectCommandBuffer::add(const indirect::DrawElementsCommand  &command)
+    {
+        if(_type != command_type::elements) {
+            throw std::invalid_argument("Indirect Command Buffer holds Draw Arrays Commands");
+        }
+        _elements.push_back(command);
+        _dirty = true;
+    }
+
+    void IndirectCommandBuffer::add(const indirect::DrawArraysCommand  &command)
+    {
+        if(_type != command_type::arrays) {
+            throw std::invalid_argument("Indirect Command Buffer holds Draw Elements Commands");
+        }
+        _arrays.push_back(command);
+        _dirty = true;
+    }
+
+    void IndirectCommandBuffer::set(std::size_t  index, const indirect::DrawElementsCommand  &command)
+    {
+        if(_type != command_type::elements) {
+            throw std::invalid_argument("Indirect Command Buffer holds Draw Arrays Commands");
+        }
+        _elements.at(index) = command;
+        _dirty = true;
+    }
+
+    void IndirectCommandBuffer::set(std::size_t  index, const indirect::DrawArraysCommand  &command)
+    {
+        if(_type != command_type::arrays) {
+            throw std::invalid_argument("Indirect Command Buffer holds Draw Elements Commands");
+        }
+        _arrays.at(index) = command;
+        _dirty = true;
+    }
+
+    void IndirectCommandBuffer::clear() noexcept
+    {
+        _elements.clear();
+        _arrays.clear();
+        _dirty = true;
+    }
+
+    void IndirectCommandBuffer::reserve(std::size_t  count)
+    {
+        if(_type == command_type::elements)
+            _elements.reserve(count);
+        else
+            _arrays.reserve(count);
+    }
+
+    void IndirectCommandBuffer::bind() const
+    {
+    #if defined(OPENGL_CORE)
+        if(_dirty) {
+            upload();
+        }
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _id);
+    #endif
+    }
+
+    void IndirectCommandBuffer::upload() const
+    {
+    #if defined(OPENGL_CORE)
+        const auto data = _type == command_type::elements ? static_cast<const void*>(_elements.data()) : static_cast<const void*>(_arrays.data());
+        const auto size = this->size() * command_stride();
+
+        if(size > _capacity)
+        {
+            //Grows geometrically, the commands of a frame usually change in count a little
+            _capacity = std::max(size, _capacity * 2);
+        #if OPENGL_CORE >= 40500
+            glNamedBufferData(_id, gsl::narrow_cast<GLsizeiptr>(_capacity), nullptr, GL_DYNAMIC_DRAW);
+        #else
+            glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+            glBufferData(GL_COPY_WRITE_BUFFER, gsl::narrow_cast<GLsizeiptr>(_capacity), nullptr, GL_DYNAMIC_DRAW);
+        #endif
+            MemoryTracker::get_instance().record(memory::resource::buffer, _id, _capacity);
+        }
+
+        if(size > 0)
+        {
+        #if OPENGL_CORE >= 40500
+            glNamedBufferSubData(_id, 0, gsl::narrow_cast<GLsizeiptr>(size), data);
+        #else
+            glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, 0, gsl::narrow_cast<GLsizeiptr>(size), data);
+        #endif
+        }
+    #endif
+        _dirty = false;
+    }
+
+    auto IndirectCommandBuffer::get_command_type() const noexcept -> command_type
+    {
+        return _type;
+    }
+
+    auto IndirectCommandBuffer::size() const noexcept -> std::size_t
+    {
+        return _type == command_type::elements ? _elements.size() : _arrays.size();
+    }
+
+    auto IndirectCommandBuffer::empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    auto IndirectCommandBuffer::command_stride() const noexcept -> std::size_t
+    {
+        return _type == command_type::elements ? sizeof(indirect::DrawElementsCommand) : sizeof(indirect::DrawArraysCommand);
+    }
+
+    auto IndirectCommandBuffer::elements_commands() const -> gsl::span<const indirect::DrawElementsCommand>
+    {
+        return { _elements.data(), gsl::narrow_cast<std::ptrdiff_t>(_elements.size()) };
+    }
+
+    auto IndirectCommandBuffer::arrays_commands() const -> gsl::span<const indirect::DrawArraysCommand>
+    {
+        return { _arrays.data(), gsl::narrow_cast<std::ptrdiff_t>(_arrays.size()) };
+    }
+}
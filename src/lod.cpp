@@ -0,0 +1,111 @@
+
+
+#include "glcore/lod.hpp"
+#include "glcore/mesh_optimizer.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+namespace nitros::glcore
+{
+    LodChain::LodChain(gsl::span<const std::uint32_t>  indices, gsl::span<const float>  positions, std::size_t  position_stride,
+                       std::size_t  max_levels, float  reduction)
+    {
+        if(max_levels == 0) {
+            throw std::invalid_argument("LOD Chain needs at least one level");
+        }
+        if(!(reduction > 0.f && reduction < 1.f)) {
+            throw std::invalid_argument("LOD reduction has to be between 0 and 1");
+        }
+        const auto vertex_count = static_cast<std::size_t>(positions.size()) / std::max<std::size_t>(position_stride, 1);
+
+        auto level = mesh::optimize_vertex_cache(indices, vertex_count);
+        auto error = 0.f;
+        while(true)
+        {
+            _levels.push_back({ gsl::narrow<std::uint32_t>(_indices.size()), gsl::narrow<std::uint32_t>(level.size()), error });
+            _indices.insert(_indices.end(), level.begin(), level.end());
+
+            if(_levels.size() == max_levels) {
+                break;
+            }
+
+            const auto target = static_cast<std::size_t>( static_cast<float>(level.size()) * reduction ) / 3 * 3;
+            auto level_error  = 0.f;
+            auto simplified   = mesh::simplify(level, positions, position_stride, target, std::numeric_limits<float>::max(), &level_error);
+
+            //Locked borders or flips stop the collapses early, a level barely smaller isn't worth its memory
+            if(simplified.empty() || static_cast<float>(simplified.size()) > static_cast<float>(level.size()) * (reduction + 1.f) / 2.f) {
+                break;
+            }
+            level = mesh::optimize_vertex_cache(simplified, vertex_count);
+            //Errors of consecutive simplifications add up at most
+            error += level_error;
+        }
+    }
+
+    void LodChain::write_to(Buffer  &index_buffer) const
+    {
+        auto rows = std::vector<std::array<std::uint32_t, 1>>{};
+        rows.reserve(_indices.size());
+        for(auto i : _indices) {
+            rows.push_back({i});
+        }
+        index_buffer.write_data(rows);
+    }
+
+    auto LodChain::levels() const noexcept -> const std::vector<lod::Level>&
+    {
+        return _levels;
+    }
+
+    auto LodChain::indices() const noexcept -> const std::vector<std::uint32_t>&
+    {
+        return _indices;
+    }
+
+    LodSelector::LodSelector(float  viewport_height, float  vertical_fov, float  pixel_error)
+        :_viewport_height{viewport_height}
+        ,_vertical_fov{vertical_fov}
+        ,_pixel_error{pixel_error}
+    {}
+
+    void LodSelector::set_viewport_height(float  viewport_height) noexcept
+    {
+        _viewport_height = viewport_height;
+    }
+
+    void LodSelector::set_vertical_fov(float  vertical_fov) noexcept
+    {
+        _vertical_fov = vertical_fov;
+    }
+
+    void LodSelector::set_pixel_error(float  pixel_error) noexcept
+    {
+        _pixel_error = pixel_error;
+    }
+
+    auto LodSelector::select(const LodChain  &chain, float  distance, float  scale) const noexcept -> std::size_t
+    {
+        //Pixels per world unit at distance
+        const auto pixels = _viewport_height / (2.f * std::tan(_vertical_fov / 2.f) * std::max(distance, 1e-4f));
+
+        const auto &levels = chain.levels();
+        auto selected = std::size_t{0};
+        for(auto l = std::size_t{1}; l < levels.size(); l++)
+        {
+            if(levels[l].error * scale * pixels > _pixel_error) {
+                break;
+            }
+            selected = l;
+        }
+        return selected;
+    }
+
+    void LodSelector::draw(const VertexArray  &vertex_array, const LodChain  &chain, float  distance, float  scale) const
+    {
+        const auto &level = chain.levels().at(select(chain, distance, scale));
+        vertex_array.draw_index_count(level.index_offset, level.index_count);
+    }
+}
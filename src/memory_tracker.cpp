@@ -0,0 +1,176 @@
+
+
+#include "glcore/memory_tracker.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace nitros::glcore
+{
+    namespace
+    {
+        const auto untagged = std::string{"untagged"};
+
+        constexpr auto index(memory::resource  type) -> std::size_t
+        {
+            return static_cast<std::size_t>(type);
+        }
+    }
+
+    namespace memory
+    {
+        TagScope::TagScope(std::string  tag)
+        {
+            MemoryTracker::get_instance()._tag_stack.push_back(std::move(tag));
+        }
+
+        TagScope::~TagScope()
+        {
+            MemoryTracker::get_instance()._tag_stack.pop_back();
+        }
+    }
+
+    MemoryTracker::MemoryTracker()
+        :_records{}
+        ,_resource_bytes{}
+        ,_tag_bytes{}
+        ,_tag_stack{}
+        ,_total{0}
+        ,_peak{0}
+        ,_budget{0}
+        ,_callback{}
+        ,_in_callback{false}
+    {}
+
+    MemoryTracker&  MemoryTracker::get_instance()
+    {
+        static MemoryTracker instance;
+        return instance;
+    }
+
+    void MemoryTracker::record(memory::resource  type, std::uint32_t  id, std::size_t  bytes)
+    {
+        const auto& tag = _tag_stack.empty() ? untagged : _tag_stack.back();
+        auto [itr, inserted] = _records.try_emplace({type, id}, Record{bytes, tag});
+        if(!inserted)
+        {
+            remove(type, itr->second.tag, itr->second.bytes);
+            //Objects handed out again by the ObjectPool move to the current tag
+            if(!_tag_stack.empty()) {
+                itr->second.tag = tag;
+            }
+            itr->second.bytes = bytes;
+        }
+        add(type, itr->second.tag, bytes);
+        check_budget();
+    }
+
+    void MemoryTracker::erase(memory::resource  type, std::uint32_t  id)
+    {
+        auto itr = _records.find({type, id});
+        if(itr == _records.end()) {
+            return;
+        }
+        remove(type, itr->second.tag, itr->second.bytes);
+        _records.erase(itr);
+    }
+
+    void MemoryTracker::retag(memory::resource  type, std::uint32_t  id, const std::string  &tag)
+    {
+        auto itr = _records.find({type, id});
+        if(itr == _records.end()) {
+            LOG_W("Memory Tracker retag of an unknown object {}", id);
+            return;
+        }
+        remove(type, itr->second.tag, itr->second.bytes);
+        itr->second.tag = tag;
+        add(type, tag, itr->second.bytes);
+    }
+
+    void MemoryTracker::set_budget(std::size_t  bytes, budget_callback  callback)
+    {
+        _budget   = bytes;
+        _callback = std::move(callback);
+    }
+
+    void MemoryTracker::reset_peak() noexcept
+    {
+        _peak = _total;
+    }
+
+    auto MemoryTracker::budget() const noexcept -> std::size_t
+    {
+        return _budget;
+    }
+
+    auto MemoryTracker::total_bytes() const noexcept -> std::size_t
+    {
+        return _total;
+    }
+
+    auto MemoryTracker::peak_bytes() const noexcept -> std::size_t
+    {
+        return _peak;
+    }
+
+    auto MemoryTracker::bytes(memory::resource  type) const noexcept -> std::size_t
+    {
+        return _resource_bytes[index(type)];
+    }
+
+    auto MemoryTracker::bytes(const std::string  &tag) const -> std::size_t
+    {
+        auto itr = _tag_bytes.find(tag);
+        return itr != _tag_bytes.end() ? itr->second : 0;
+    }
+
+    auto MemoryTracker::tags() const -> const std::map<std::string, std::size_t>&
+    {
+        return _tag_bytes;
+    }
+
+    auto MemoryTracker::object_count() const noexcept -> std::size_t
+    {
+        return _records.size();
+    }
+
+    void MemoryTracker::add(memory::resource  type, const std::string  &tag, std::size_t  bytes)
+    {
+        _resource_bytes[index(type)] += bytes;
+        _tag_bytes[tag] += bytes;
+        _total += bytes;
+        _peak = std::max(_peak, _total);
+    }
+
+    void MemoryTracker::remove(memory::resource  type, const std::string  &tag, std::size_t  bytes)
+    {
+        _resource_bytes[index(type)] -= bytes;
+        _total -= bytes;
+
+        auto itr = _tag_bytes.find(tag);
+        if(itr != _tag_bytes.end())
+        {
+            itr->second -= bytes;
+            if(itr->second == 0) {
+                _tag_bytes.erase(itr);
+            }
+        }
+    }
+
+    void MemoryTracker::check_budget()
+    {
+        if(_budget == 0 || _total <= _budget || !_callback || _in_callback) {
+            return;
+        }
+
+        //Objects destroyed by the callback call erase, allocations inside it don't call back again
+        _in_callback = true;
+        try {
+            _callback(_total, _budget);
+        }
+        catch(...) {
+            _in_callback = false;
+            throw;
+        }
+        _in_callback = false;
+    }
+}
@@ -1,5 +1,4 @@
 
-
 #include "glcore/memorymap.hpp"
 #include "glcore/commands.hpp"
 #include "platform/gl.hpp"
@@ -7,44 +6,66 @@
 
 namespace nitros::glcore
 {
-#if defined(OPENGL_CORE)
-    constexpr auto return_type(const _memorymap::type type_){
-        if ( type_ == _memorymap::type::READ_WRITE )
-            return GL_READ_WRITE;
-        else if ( type_ == _memorymap::type::READ )
-            return GL_READ_ONLY;
-        else
-            return GL_WRITE_ONLY;
-    }
-#else
     constexpr auto return_type(const _memorymap::type type_){
         if ( type_ == _memorymap::type::READ_WRITE )
             return GL_MAP_READ_BIT | GL_MAP_WRITE_BIT;
         else if ( type_ == _memorymap::type::READ )
             return GL_MAP_READ_BIT;
         else
-            return GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+            return GL_MAP_WRITE_BIT;
+    }
+
+    constexpr auto access_bits(const _memorymap::type type_, const _memorymap::flags flags_) -> GLbitfield {
+        using _memorymap::flags;
+        using _memorymap::has_flag;
+
+        GLbitfield bits = return_type(type_);
+        if( has_flag(flags_, flags::INVALIDATE_RANGE) )
+            bits |= GL_MAP_INVALIDATE_RANGE_BIT;
+        if( has_flag(flags_, flags::INVALIDATE_BUFFER) )
+            bits |= GL_MAP_INVALIDATE_BUFFER_BIT;
+        if( has_flag(flags_, flags::UNSYNCHRONIZED) )
+            bits |= GL_MAP_UNSYNCHRONIZED_BIT;
+        if( has_flag(flags_, flags::EXPLICIT_FLUSH) )
+            bits |= GL_MAP_FLUSH_EXPLICIT_BIT;
+        return bits;
     }
-#endif
 
     template <_memorymap::type type_>
     MemoryMap<type_>::MemoryMap(const Buffer  &buffer)
+        :MemoryMap{buffer, 0, buffer.size_bytes()}
+    {}
+
+    template <_memorymap::type type_>
+    MemoryMap<type_>::MemoryMap(const Buffer  &buffer, std::size_t  offset, std::size_t  length, _memorymap::flags  flags)
         :_buffer{buffer}
         ,_buffer_ptr{nullptr}
+        ,_offset{offset}
+        ,_length{length}
+        ,_flags{flags}
     {
+        if constexpr(type_ == _memorymap::type::READ) {
+            if(flags != _memorymap::flags::NONE) {
+                throw std::invalid_argument("Memory Map flags need write access");
+            }
+        }
+        else if constexpr(type_ == _memorymap::type::READ_WRITE) {
+            //GL rejects invalidation and unsynchronized access together with read access
+            using _memorymap::has_flag;
+            if(has_flag(flags, _memorymap::flags::INVALIDATE_RANGE) || has_flag(flags, _memorymap::flags::INVALIDATE_BUFFER) ||
+               has_flag(flags, _memorymap::flags::UNSYNCHRONIZED)) {
+                throw std::invalid_argument("Memory Map invalidate and unsynchronized flags need a WRITE map");
+            }
+        }
+        if(offset + length > _buffer.size_bytes()) {
+            throw std::out_of_range("Memory Map range exceeds the Buffer size");
+        }
+
 #if OPENGL_CORE >= 40500
-        _buffer_ptr = glMapNamedBuffer(_buffer.get_id(), return_type(type_) );
-        //buffer.bind(Buffer::buffer_type::ARRAY_BUFFER);
-        //_buffer_ptr = glMapBufferRange(GL_ARRAY_BUFFER, 0, _buffer.get_elements_count() * _buffer.row_stride() / _buffer.vec_length(), return_type(type_));
-        //glGetNamedBufferPointerv(_buffer.get_id(), GL_BUFFER_MAP_POINTER, &_buffer_ptr);
+        _buffer_ptr = glMapNamedBufferRange(_buffer.get_id(), _offset, _length, access_bits(type_, _flags) );
 #else
-    if(buffer.get_value_type() == Buffer::value_type::UINT){
-        buffer.bind(Buffer::buffer_type::ELEMENT_BUFFER);
-        _buffer_ptr = glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, _buffer.get_elements_count() * _buffer.row_stride() / _buffer.vec_length(), return_type(type_));
-    }else{
-        buffer.bind(Buffer::buffer_type::ARRAY_BUFFER);
-        _buffer_ptr = glMapBufferRange(GL_ARRAY_BUFFER, 0, _buffer.get_elements_count() * _buffer.row_stride() / _buffer.vec_length(), return_type(type_));
-    }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get_id());
+        _buffer_ptr = glMapBufferRange(GL_COPY_WRITE_BUFFER, _offset, _length, access_bits(type_, _flags));
 #endif
     if(_buffer_ptr == NULL){
         auto errors = command::error();
@@ -57,23 +78,41 @@ namespace nitros::glcore
 #if OPENGL_CORE >= 40500
         glUnmapNamedBuffer(_buffer.get_id());
 #else
-        auto gl_array_type = [buffer_type = _buffer.get_value_type()](){
-            if(buffer_type == glcore::Buffer::value_type::UINT)
-                return GL_ELEMENT_ARRAY_BUFFER;
-            else
-                return GL_ARRAY_BUFFER;
-        }();
-        if constexpr(type_ == _memorymap::type::WRITE){
-            glFlushMappedBufferRange(gl_array_type, 0, _buffer.get_elements_count() * _buffer.row_stride() / _buffer.vec_length());
-        }
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get_id());
         auto errors = command::error();
-        glUnmapBuffer(gl_array_type);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
 #endif
     }
 
     template <_memorymap::type type_>
     gsl::span<std::uint8_t>  MemoryMap<type_>::get_data() const {
-        return { static_cast<std::uint8_t*>(_buffer_ptr), gsl::narrow_cast<std::ptrdiff_t>( _buffer.get_elements_count() * _buffer.row_stride() / _buffer.vec_length()) };
+        return { static_cast<std::uint8_t*>(_buffer_ptr), gsl::narrow_cast<std::ptrdiff_t>( _length ) };
+    }
+
+    template <_memorymap::type type_>
+    void MemoryMap<type_>::flush(std::size_t  offset, std::size_t  length) const {
+        if(!_memorymap::has_flag(_flags, _memorymap::flags::EXPLICIT_FLUSH)) {
+            throw std::logic_error("Memory Map flush needs EXPLICIT_FLUSH");
+        }
+        if(offset + length > _length) {
+            throw std::out_of_range("Memory Map flush range exceeds the mapped range");
+        }
+#if OPENGL_CORE >= 40500
+        glFlushMappedNamedBufferRange(_buffer.get_id(), offset, length);
+#else
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _buffer.get_id());
+        glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, offset, length);
+#endif
+    }
+
+    template <_memorymap::type type_>
+    auto MemoryMap<type_>::offset() const noexcept -> std::size_t {
+        return _offset;
+    }
+
+    template <_memorymap::type type_>
+    auto MemoryMap<type_>::length() const noexcept -> std::size_t {
+        return _length;
     }
 
     template class MemoryMap<_memorymap::type::READ_WRITE>;
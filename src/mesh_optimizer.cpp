@@ -0,0 +1,645 @@
+
+
+#include "glcore/mesh_optimizer.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <numeric>
+#include <queue>
+
+namespace nitros::glcore::mesh
+{
+    namespace
+    {
+        void validate(gsl::span<const std::uint32_t>  indices, std::size_t  vertex_count)
+        {
+            if(indices.size() % 3 != 0) {
+                throw std::invalid_argument("Index count is not a multiple of 3");
+            }
+            for(auto i : indices) {
+                if(i >= vertex_count) {
+                    throw std::out_of_range("Index references a vertex beyond the vertex count");
+                }
+            }
+        }
+
+        //FIFO post transform cache, a hit doesn't move the vertex
+        class FifoCache
+        {
+            public:
+            FifoCache(std::size_t  vertex_count, std::uint32_t  cache_size)
+                :_timestamps(vertex_count, 0)
+                ,_cache_size{cache_size}
+                ,_time{cache_size + 1}
+            {}
+
+            //Returns true for a miss
+            auto access(std::uint32_t  vertex) -> bool
+            {
+                if(_time - _timestamps[vertex] > _cache_size) {
+                    _timestamps[vertex] = _time++;
+                    return true;
+                }
+                return false;
+            }
+
+            void clear()
+            {
+                //Every stored timestamp falls out of the cache
+                _time += _cache_size + 1;
+            }
+
+            private:
+            std::vector<std::size_t>    _timestamps;
+            std::size_t                 _cache_size;
+            std::size_t                 _time;
+        };
+
+        //Triangles of each vertex in compressed rows
+        struct Adjacency
+        {
+            std::vector<std::uint32_t>  offsets;
+            std::vector<std::uint32_t>  triangles;
+        };
+
+        auto build_adjacency(gsl::span<const std::uint32_t>  indices, std::size_t  vertex_count) -> Adjacency
+        {
+            auto adjacency = Adjacency{};
+            adjacency.offsets.assign(vertex_count + 1, 0);
+            adjacency.triangles.resize(indices.size());
+
+            for(auto i : indices) {
+                adjacency.offsets[i + 1]++;
+            }
+            std::partial_sum(adjacency.offsets.begin(), adjacency.offsets.end(), adjacency.offsets.begin());
+
+            auto fill = std::vector<std::uint32_t>(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+            for(auto i = std::size_t{0}; i < static_cast<std::size_t>(indices.size()); i++) {
+                adjacency.triangles[fill[indices[i]]++] = gsl::narrow_cast<std::uint32_t>(i / 3);
+            }
+            return adjacency;
+        }
+
+        using vec3 = std::array<float, 3>;
+
+        auto position(gsl::span<const float>  positions, std::size_t  stride, std::uint32_t  vertex) -> vec3
+        {
+            const auto base = vertex * stride;
+            return { positions[base], positions[base + 1], positions[base + 2] };
+        }
+
+        //Symmetric 4x4 matrix of the summed squared plane distances
+        struct Quadric
+        {
+            std::array<double, 10>  m{};
+
+            static auto plane(double  a, double  b, double  c, double  d, double  weight) -> Quadric
+            {
+                auto q = Quadric{};
+                q.m = { a * a, a * b, a * c, a * d,
+                               b * b, b * c, b * d,
+                                      c * c, c * d,
+                                             d * d };
+                for(auto &v : q.m) {
+                    v *= weight;
+                }
+                return q;
+            }
+
+            auto operator+=(const Quadric  &other) -> Quadric&
+            {
+                for(auto i = std::size_t{0}; i < m.size(); i++) {
+                    m[i] += other.m[i];
+                }
+                return *this;
+            }
+
+            [[nodiscard]] auto error(const vec3  &p) const -> double
+            {
+                const double x = p[0], y = p[1], z = p[2];
+                return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z + 2 * m[3] * x
+                     + m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y
+                     + m[7] * z * z + 2 * m[8] * z
+                     + m[9];
+            }
+        };
+
+        auto sub(const vec3  &a, const vec3  &b) -> vec3 { return { a[0] - b[0], a[1] - b[1], a[2] - b[2] }; }
+        auto cross(const vec3  &a, const vec3  &b) -> vec3 { return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] }; }
+        auto dot(const vec3  &a, const vec3  &b) -> float { return a[0] * b[0] + a[1] * b[1] + a[2] * b[2]; }
+
+        //Borders weigh more than any interior plane so a collapse along them is preferred over one leaving them
+        constexpr auto border_weight = 10.0;
+        constexpr auto max_turn = 0.25f;
+    }
+
+    auto analyze_vertex_cache(gsl::span<const std::uint32_t>  indices, std::size_t  vertex_count, std::uint32_t  cache_size) -> CacheStats
+    {
+        validate(indices, vertex_count);
+
+        auto cache      = FifoCache{vertex_count, cache_size};
+        auto referenced = std::vector<bool>(vertex_count, false);
+        auto stats      = CacheStats{0, 0.f, 0.f};
+        auto unique     = std::size_t{0};
+
+        for(auto i : indices)
+        {
+            if(cache.access(i)) {
+                stats.vertices_transformed++;
+            }
+            if(!referenced[i]) {
+                referenced[i] = true;
+                unique++;
+            }
+        }
+
+        const auto triangles = indices.size() / 3;
+        stats.acmr = triangles ? static_cast<float>(stats.vertices_transformed) / static_cast<float>(triangles) : 0.f;
+        stats.atvr = unique ? static_cast<float>(stats.vertices_transformed) / static_cast<float>(unique) : 0.f;
+        return stats;
+    }
+
+    auto optimize_vertex_cache(gsl::span<const std::uint32_t>  indices, std::size_t  vertex_count, std::uint32_t  cache_size) -> std::vector<std::uint32_t>
+    {
+        validate(indices, vertex_count);
+
+        const auto adjacency = build_adjacency(indices, vertex_count);
+        const auto triangle_count = static_cast<std::size_t>(indices.size()) / 3;
+
+        auto live = std::vector<std::int64_t>(vertex_count);
+        for(auto v = std::size_t{0}; v < vertex_count; v++) {
+            live[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+        }
+
+        auto timestamps = std::vector<std::int64_t>(vertex_count, 0);
+        auto emitted    = std::vector<bool>(triangle_count, false);
+        auto dead_end   = std::vector<std::uint32_t>{};
+        auto candidates = std::vector<std::uint32_t>{};
+        auto output     = std::vector<std::uint32_t>{};
+        output.reserve(indices.size());
+
+        const auto k = static_cast<std::int64_t>(cache_size);
+        auto time    = k + 1;
+        auto cursor  = std::size_t{0};
+
+        //Vertex with triangles left, from the dead end stack or the next in input order
+        auto skip_dead_end = [&]() -> std::int64_t
+        {
+            while(!dead_end.empty())
+            {
+                auto d = dead_end.back();
+                dead_end.pop_back();
+                if(live[d] > 0) {
+                    return d;
+                }
+            }
+            for(; cursor < vertex_count; cursor++) {
+                if(live[cursor] > 0) {
+                    return static_cast<std::int64_t>(cursor);
+                }
+            }
+            return -1;
+        };
+
+        auto fanning = vertex_count ? skip_dead_end() : -1;
+        while(fanning >= 0)
+        {
+            candidates.clear();
+
+            const auto f = static_cast<std::size_t>(fanning);
+            for(auto t = adjacency.offsets[f]; t < adjacency.offsets[f + 1]; t++)
+            {
+                const auto triangle = adjacency.triangles[t];
+                if(emitted[triangle]) {
+                    continue;
+                }
+                for(auto c = 0; c < 3; c++)
+                {
+                    const auto v = indices[triangle * 3 + c];
+                    output.push_back(v);
+                    dead_end.push_back(v);
+                    candidates.push_back(v);
+                    live[v]--;
+                    if(time - timestamps[v] > k) {
+                        timestamps[v] = time++;
+                    }
+                }
+                emitted[triangle] = true;
+            }
+
+            //Prefer the candidate which stays longest in the cache after its remaining triangles are emitted
+            auto best = std::int64_t{-1};
+            auto best_priority = std::int64_t{-1};
+            for(auto v : candidates)
+            {
+                if(live[v] <= 0) {
+                    continue;
+                }
+                auto priority = std::int64_t{0};
+                if(time - timestamps[v] + 2 * live[v] <= k) {
+                    priority = time - timestamps[v];
+                }
+                if(priority > best_priority) {
+                    best_priority = priority;
+                    best = v;
+                }
+            }
+            fanning = best >= 0 ? best : skip_dead_end();
+        }
+
+        return output;
+    }
+
+    auto optimize_overdraw(gsl::span<const std::uint32_t>  indices, gsl::span<const float>  positions, std::size_t  position_stride,
+                           std::uint32_t  cache_size, float  threshold) -> std::vector<std::uint32_t>
+    {
+        if(position_stride < 3) {
+            throw std::invalid_argument("Position stride is smaller than 3 floats");
+        }
+        const auto vertex_count = static_cast<std::size_t>(positions.size()) / position_stride;
+        validate(indices, vertex_count);
+
+        const auto triangle_count = static_cast<std::size_t>(indices.size()) / 3;
+        if(triangle_count == 0) {
+            return {};
+        }
+
+        //Hard boundaries are the triangles missing all three vertices, Tipsify jumped to a new fan there
+        auto misses = std::vector<std::uint32_t>(triangle_count);
+        {
+            auto cache = FifoCache{vertex_count, cache_size};
+            for(auto t = std::size_t{0}; t < triangle_count; t++) {
+                for(auto c = 0; c < 3; c++) {
+                    misses[t] += cache.access(indices[t * 3 + c]) ? 1u : 0u;
+                }
+            }
+        }
+        const auto total_misses = std::accumulate(misses.begin(), misses.end(), std::size_t{0});
+        const auto mesh_acmr    = static_cast<float>(total_misses) / static_cast<float>(triangle_count);
+
+        //Soft boundaries split a hard cluster where a restart keeps the ACMR close to the one of the input
+        auto clusters = std::vector<std::size_t>{0};
+        {
+            auto cache = FifoCache{vertex_count, cache_size};
+            auto cluster_misses = std::size_t{0};
+            auto cluster_start  = std::size_t{0};
+            for(auto t = std::size_t{0}; t < triangle_count; t++)
+            {
+                auto triangle_misses = 0u;
+                for(auto c = 0; c < 3; c++) {
+                    triangle_misses += cache.access(indices[t * 3 + c]) ? 1u : 0u;
+                }
+                cluster_misses += triangle_misses;
+
+                const auto next = t + 1;
+                if(next == triangle_count) {
+                    break;
+                }
+                const auto hard = misses[next] == 3;
+                const auto soft = static_cast<float>(cluster_misses) <= threshold * mesh_acmr * static_cast<float>(next - cluster_start);
+                if(hard || soft)
+                {
+                    clusters.push_back(next);
+                    cache.clear();
+                    cluster_misses = 0;
+                    cluster_start  = next;
+                }
+            }
+        }
+        clusters.push_back(triangle_count);
+
+        //Area weighted centroid and normal of each cluster
+        const auto cluster_count = clusters.size() - 1;
+        auto centroids = std::vector<vec3>(cluster_count, vec3{0.f, 0.f, 0.f});
+        auto normals   = std::vector<vec3>(cluster_count, vec3{0.f, 0.f, 0.f});
+        auto areas     = std::vector<float>(cluster_count, 0.f);
+        auto mesh_centroid = vec3{0.f, 0.f, 0.f};
+        auto mesh_area     = 0.f;
+
+        for(auto k = std::size_t{0}; k < cluster_count; k++)
+        {
+            for(auto t = clusters[k]; t < clusters[k + 1]; t++)
+            {
+                const auto p0 = position(positions, position_stride, indices[t * 3]);
+                const auto p1 = position(positions, position_stride, indices[t * 3 + 1]);
+                const auto p2 = position(positions, position_stride, indices[t * 3 + 2]);
+
+                const auto e1 = vec3{ p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+                const auto e2 = vec3{ p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+                const auto n  = vec3{ e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0] };
+                const auto area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) * 0.5f;
+
+                for(auto c = 0; c < 3; c++)
+                {
+                    const auto center = (p0[c] + p1[c] + p2[c]) / 3.f;
+                    centroids[k][c] += center * area;
+                    normals[k][c]   += n[c];
+                    mesh_centroid[c] += center * area;
+                }
+                areas[k]  += area;
+                mesh_area += area;
+            }
+        }
+        for(auto c = 0; c < 3; c++) {
+            mesh_centroid[c] = mesh_area > 0.f ? mesh_centroid[c] / mesh_area : 0.f;
+        }
+
+        //Clusters far out along their normal are likely in front, drawing them first lets the depth test reject the rest
+        auto sort_keys = std::vector<float>(cluster_count, 0.f);
+        for(auto k = std::size_t{0}; k < cluster_count; k++)
+        {
+            const auto &n = normals[k];
+            const auto length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if(areas[k] <= 0.f || length <= 0.f) {
+                continue;
+            }
+            auto key = 0.f;
+            for(auto c = 0; c < 3; c++) {
+                key += (centroids[k][c] / areas[k] - mesh_centroid[c]) * n[c] / length;
+            }
+            sort_keys[k] = key;
+        }
+
+        auto order = std::vector<std::size_t>(cluster_count);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::stable_sort(order.begin(), order.end(), [&sort_keys](auto lhs, auto rhs) { return sort_keys[lhs] > sort_keys[rhs]; });
+
+        auto output = std::vector<std::uint32_t>{};
+        output.reserve(indices.size());
+        for(auto k : order) {
+            output.insert(output.end(), indices.begin() + clusters[k] * 3, indices.begin() + clusters[k + 1] * 3);
+        }
+        return output;
+    }
+
+    auto simplify(gsl::span<const std::uint32_t>  indices, gsl::span<const float>  positions, std::size_t  position_stride,
+                  std::size_t  target_index_count, float  target_error, float*  result_error) -> std::vector<std::uint32_t>
+    {
+        if(position_stride < 3) {
+            throw std::invalid_argument("Position stride is smaller than 3 floats");
+        }
+        const auto vertex_count = static_cast<std::size_t>(positions.size()) / position_stride;
+        validate(indices, vertex_count);
+
+        using triangle = std::array<std::uint32_t, 3>;
+        auto triangles  = std::vector<triangle>{};
+        auto points     = std::vector<vec3>(vertex_count);
+        auto quadrics   = std::vector<Quadric>(vertex_count);
+        auto vertex_triangles = std::vector<std::vector<std::uint32_t>>(vertex_count);
+
+        for(auto v = std::size_t{0}; v < vertex_count; v++) {
+            points[v] = position(positions, position_stride, gsl::narrow_cast<std::uint32_t>(v));
+        }
+        for(auto i = std::size_t{0}; i < static_cast<std::size_t>(indices.size()); i += 3)
+        {
+            const auto t = triangle{ indices[i], indices[i + 1], indices[i + 2] };
+            if(t[0] == t[1] || t[1] == t[2] || t[0] == t[2]) {
+                continue;
+            }
+            for(auto v : t) {
+                vertex_triangles[v].push_back(gsl::narrow_cast<std::uint32_t>(triangles.size()));
+            }
+            triangles.push_back(t);
+        }
+
+        //Plane quadrics of the faces and the directed edges to find the borders
+        auto edges = std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t>{};
+        for(auto t = std::size_t{0}; t < triangles.size(); t++)
+        {
+            const auto &tri = triangles[t];
+            const auto n = cross(sub(points[tri[1]], points[tri[0]]), sub(points[tri[2]], points[tri[0]]));
+            const auto length = std::sqrt(dot(n, n));
+            if(length > 0.f)
+            {
+                const auto plane = Quadric::plane(n[0] / length, n[1] / length, n[2] / length, -dot(n, points[tri[0]]) / length, 1.0);
+                for(auto v : tri) {
+                    quadrics[v] += plane;
+                }
+            }
+            for(auto c = 0; c < 3; c++) {
+                edges[{ tri[c], tri[(c + 1) % 3] }] = gsl::narrow_cast<std::uint32_t>(t);
+            }
+        }
+        for(auto &[edge, t] : edges)
+        {
+            if(edges.count({ edge.second, edge.first })) {
+                continue;
+            }
+            const auto &tri = triangles[t];
+            const auto n = cross(sub(points[tri[1]], points[tri[0]]), sub(points[tri[2]], points[tri[0]]));
+            const auto e = sub(points[edge.second], points[edge.first]);
+            const auto m = cross(e, n);
+            const auto length = std::sqrt(dot(m, m));
+            if(length > 0.f)
+            {
+                const auto plane = Quadric::plane(m[0] / length, m[1] / length, m[2] / length, -dot(m, points[edge.first]) / length, border_weight);
+                quadrics[edge.first]  += plane;
+                quadrics[edge.second] += plane;
+            }
+        }
+
+        struct Collapse
+        {
+            double          cost;
+            std::uint32_t   from, to;
+            std::uint32_t   from_version, to_version;
+
+            auto operator>(const Collapse  &other) const noexcept -> bool { return cost > other.cost; }
+        };
+
+        auto versions = std::vector<std::uint32_t>(vertex_count, 0);
+        auto removed  = std::vector<bool>(triangles.size(), false);
+        auto alive    = std::vector<bool>(vertex_count, true);
+        auto queue    = std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>>{};
+
+        auto push_edges = [&](std::uint32_t  v)
+        {
+            for(auto t : vertex_triangles[v])
+            {
+                if(removed[t]) {
+                    continue;
+                }
+                for(auto w : triangles[t])
+                {
+                    if(w == v) {
+                        continue;
+                    }
+                    auto q = quadrics[v];
+                    q += quadrics[w];
+                    queue.push({ q.error(points[w]), v, w, versions[v], versions[w] });
+                    queue.push({ q.error(points[v]), w, v, versions[w], versions[v] });
+                }
+            }
+        };
+        for(auto v = std::uint32_t{0}; v < vertex_count; v++) {
+            push_edges(v);
+        }
+
+        //Moving from onto to mustn't flip or fold a remaining triangle of from
+        auto flips = [&](std::uint32_t  from, std::uint32_t  to)
+        {
+            for(auto t : vertex_triangles[from])
+            {
+                const auto &tri = triangles[t];
+                if(removed[t] || tri[0] == to || tri[1] == to || tri[2] == to) {
+                    continue;
+                }
+                auto moved = tri;
+                for(auto &v : moved) {
+                    v = v == from ? to : v;
+                }
+                const auto before = cross(sub(points[tri[1]], points[tri[0]]), sub(points[tri[2]], points[tri[0]]));
+                const auto after  = cross(sub(points[moved[1]], points[moved[0]]), sub(points[moved[2]], points[moved[0]]));
+                //Small steps add up, a turn beyond about 75 degrees counts as a flip
+                if(dot(before, after) <= max_turn * std::sqrt(dot(before, before) * dot(after, after))) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        //Link condition: the rings of from and to may only share the opposite vertices of their shared triangles,
+        //otherwise the collapse pinches the surface into a non manifold edge or vertex
+        auto ring = [&](std::uint32_t  v)
+        {
+            auto vertices = std::vector<std::uint32_t>{};
+            for(auto t : vertex_triangles[v])
+            {
+                if(removed[t]) {
+                    continue;
+                }
+                for(auto w : triangles[t]) {
+                    if(w != v)
+                        vertices.push_back(w);
+                }
+            }
+            std::sort(vertices.begin(), vertices.end());
+            vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+            return vertices;
+        };
+        auto keeps_link = [&](std::uint32_t  from, std::uint32_t  to)
+        {
+            auto opposite = std::vector<std::uint32_t>{};
+            for(auto t : vertex_triangles[from])
+            {
+                const auto &tri = triangles[t];
+                if(removed[t] || (tri[0] != to && tri[1] != to && tri[2] != to)) {
+                    continue;
+                }
+                for(auto w : tri) {
+                    if(w != from && w != to)
+                        opposite.push_back(w);
+                }
+            }
+            std::sort(opposite.begin(), opposite.end());
+            opposite.erase(std::unique(opposite.begin(), opposite.end()), opposite.end());
+
+            const auto from_ring = ring(from);
+            const auto to_ring   = ring(to);
+            auto common = std::vector<std::uint32_t>{};
+            std::set_intersection(from_ring.begin(), from_ring.end(), to_ring.begin(), to_ring.end(), std::back_inserter(common));
+            return common == opposite;
+        };
+
+        const auto max_error = static_cast<double>(target_error) * static_cast<double>(target_error);
+        auto live_triangles  = triangles.size();
+        auto largest_error   = 0.0;
+
+        while(live_triangles * 3 > target_index_count && !queue.empty())
+        {
+            const auto collapse = queue.top();
+            queue.pop();
+
+            const auto from = collapse.from;
+            const auto to   = collapse.to;
+            if(!alive[from] || !alive[to] || versions[from] != collapse.from_version || versions[to] != collapse.to_version) {
+                continue;
+            }
+            if(collapse.cost > max_error) {
+                break;
+            }
+
+            auto shared = false;
+            for(auto t : vertex_triangles[from]) {
+                const auto &tri = triangles[t];
+                shared = shared || (!removed[t] && (tri[0] == to || tri[1] == to || tri[2] == to));
+            }
+            if(!shared || flips(from, to) || !keeps_link(from, to)) {
+                continue;
+            }
+
+            for(auto t : vertex_triangles[from])
+            {
+                if(removed[t]) {
+                    continue;
+                }
+                auto &tri = triangles[t];
+                if(tri[0] == to || tri[1] == to || tri[2] == to)
+                {
+                    removed[t] = true;
+                    live_triangles--;
+                    continue;
+                }
+                for(auto &v : tri) {
+                    v = v == from ? to : v;
+                }
+                vertex_triangles[to].push_back(t);
+            }
+
+            quadrics[to] += quadrics[from];
+            alive[from] = false;
+            vertex_triangles[from].clear();
+            versions[to]++;
+            largest_error = std::max(largest_error, collapse.cost);
+
+            //Only the quadric of to changed, its edges get new costs
+            auto &around = vertex_triangles[to];
+            around.erase(std::remove_if(around.begin(), around.end(), [&removed](auto t) { return removed[t]; }), around.end());
+            push_edges(to);
+        }
+
+        if(result_error) {
+            *result_error = static_cast<float>(std::sqrt(largest_error));
+        }
+
+        auto output = std::vector<std::uint32_t>{};
+        output.reserve(live_triangles * 3);
+        for(auto t = std::size_t{0}; t < triangles.size(); t++) {
+            if(!removed[t]) {
+                output.insert(output.end(), triangles[t].begin(), triangles[t].end());
+            }
+        }
+        return output;
+    }
+
+    auto vertex_fetch_remap(gsl::span<const std::uint32_t>  indices, std::size_t  vertex_count) -> Remap
+    {
+        validate(indices, vertex_count);
+
+        auto remap = Remap{ std::vector<std::uint32_t>(vertex_count, Remap::unused), 0 };
+        for(auto i : indices)
+        {
+            if(remap.table[i] == Remap::unused) {
+                remap.table[i] = gsl::narrow_cast<std::uint32_t>(remap.vertex_count++);
+            }
+        }
+        return remap;
+    }
+
+    auto remap_indices(gsl::span<const std::uint32_t>  indices, const Remap  &remap) -> std::vector<std::uint32_t>
+    {
+        auto remapped = std::vector<std::uint32_t>{};
+        remapped.reserve(indices.size());
+        for(auto i : indices)
+        {
+            if(i >= remap.table.size() || remap.table[i] == Remap::unused) {
+                throw std::out_of_range("Index isn't covered by the remap table");
+            }
+            remapped.push_back(remap.table[i]);
+        }
+        return remapped;
+    }
+}
@@ -0,0 +1,174 @@
+
+
+#include "glcore/object_pool.hpp"
+#include "glcore/memory_tracker.hpp"
+#include "glcore/state_cache.hpp"
+#include "platform/gl.hpp"
+#include "logger.hpp"
+#include <tuple>
+#include <limits>
+
+namespace nitros::glcore
+{
+    namespace pool
+    {
+        auto operator<(const Key  &lhs, const Key  &rhs) noexcept -> bool
+        {
+            return std::tie(lhs.object, lhs.target, lhs.format, lhs.width, lhs.height, lhs.levels) <
+                   std::tie(rhs.object, rhs.target, rhs.format, rhs.width, rhs.height, rhs.levels);
+        }
+    }
+
+    namespace
+    {
+        void delete_object(pool::kind  object, std::uint32_t  id)
+        {
+            auto& tracker = MemoryTracker::get_instance();
+            switch (object)
+            {
+                case pool::kind::buffer:
+                    tracker.erase(memory::resource::buffer, id);
+                    glDeleteBuffers(1, &id);
+                    break;
+                case pool::kind::texture:
+                    tracker.erase(memory::resource::texture, id);
+                    StateCache::get_instance().forget_texture(id);
+                    glDeleteTextures(1, &id);
+                    break;
+                case pool::kind::renderbuffer:
+                    tracker.erase(memory::resource::renderbuffer, id);
+                    glDeleteRenderbuffers(1, &id);
+                    break;
+                case pool::kind::framebuffer:
+                    StateCache::get_instance().forget_framebuffer(id);
+                    glDeleteFramebuffers(1, &id);
+                    break;
+            }
+        }
+    }
+
+    ObjectPool::ObjectPool()
+        :_objects{}
+        ,_capacity{0}
+        ,_pooled_bytes{0}
+        ,_pooled_count{0}
+        ,_release_counter{0}
+    {}
+
+    ObjectPool&  ObjectPool::get_instance()
+    {
+        static ObjectPool instance;
+        return instance;
+    }
+
+    void ObjectPool::set_capacity(std::size_t  bytes)
+    {
+        _capacity = bytes;
+        trim(bytes);
+    }
+
+    void ObjectPool::trim(std::size_t  bytes)
+    {
+        while(_pooled_count > 0 && _pooled_bytes > bytes) {
+            evict_oldest();
+        }
+    }
+
+    void ObjectPool::clear()
+    {
+        trim(0);
+    }
+
+    auto ObjectPool::acquire(const pool::Key  &key) -> std::optional<std::uint32_t>
+    {
+        auto itr = _objects.find(key);
+        if(itr == _objects.end()) {
+            return std::nullopt;
+        }
+
+        //Most recently released object, its storage is most likely resident
+        auto entry = itr->second.back();
+        itr->second.pop_back();
+        if(itr->second.empty()) {
+            _objects.erase(itr);
+        }
+
+        _pooled_bytes -= entry.bytes;
+        _pooled_count--;
+        return entry.id;
+    }
+
+    auto ObjectPool::release(const pool::Key  &key, std::uint32_t  id, std::size_t  bytes) -> bool
+    {
+        if(!enabled() || bytes > _capacity) {
+            return false;
+        }
+        while(_pooled_count > 0 && _pooled_bytes + bytes > _capacity) {
+            evict_oldest();
+        }
+
+        _objects[key].push_back(Entry{id, bytes, _release_counter++});
+        _pooled_bytes += bytes;
+        _pooled_count++;
+        return true;
+    }
+
+    auto ObjectPool::enabled() const noexcept -> bool
+    {
+        return _capacity > 0;
+    }
+
+    auto ObjectPool::capacity() const noexcept -> std::size_t
+    {
+        return _capacity;
+    }
+
+    auto ObjectPool::pooled_bytes() const noexcept -> std::size_t
+    {
+        return _pooled_bytes;
+    }
+
+    auto ObjectPool::pooled_count() const noexcept -> std::size_t
+    {
+        return _pooled_count;
+    }
+
+    auto ObjectPool::size_class(std::size_t  size) noexcept -> std::size_t
+    {
+        if(size == 0) {
+            return 0;
+        }
+        auto size_class = std::size_t{256};
+        while(size_class < size) {
+            size_class <<= 1u;
+        }
+        return size_class;
+    }
+
+    void ObjectPool::evict_oldest()
+    {
+        //Entries of a key are ordered by release, the oldest one is the front of some key
+        auto oldest = _objects.end();
+        auto oldest_release = std::numeric_limits<std::uint64_t>::max();
+        for(auto itr = _objects.begin(); itr != _objects.end(); ++itr) {
+            if(itr->second.front().released < oldest_release) {
+                oldest_release = itr->second.front().released;
+                oldest = itr;
+            }
+        }
+        if(oldest == _objects.end()) {
+            return;
+        }
+
+        auto entry = oldest->second.front();
+        oldest->second.erase(oldest->second.begin());
+        delete_object(oldest->first.object, entry.id);
+        LOG_D("Object Pool evicted object {} of {} bytes", entry.id, entry.bytes);
+
+        if(oldest->second.empty()) {
+            _objects.erase(oldest);
+        }
+        _pooled_bytes -= entry.bytes;
+        _pooled_count--;
+    }
+}
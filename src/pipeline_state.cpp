@@ -0,0 +1,319 @@
+
+
+#include "glcore/pipeline_state.hpp"
+#include "glcore/state_cache.hpp"
+#include "utils/gl_conversions.hpp"
+#include <cstring>
+#include <type_traits>
+
+namespace nitros::glcore
+{
+    namespace
+    {
+        auto to_glStencilOp(pipeline::stencil_op  op) -> GLenum
+        {
+            using pipeline::stencil_op;
+            switch (op)
+            {
+                case stencil_op::zero           : return GL_ZERO;
+                case stencil_op::replace        : return GL_REPLACE;
+                case stencil_op::increment      : return GL_INCR;
+                case stencil_op::increment_wrap : return GL_INCR_WRAP;
+                case stencil_op::decrement      : return GL_DECR;
+                case stencil_op::decrement_wrap : return GL_DECR_WRAP;
+                case stencil_op::invert         : return GL_INVERT;
+                default                         : return GL_KEEP;
+            }
+        }
+
+        auto to_glCullFace(Rasterizer::cull  face) -> GLenum
+        {
+            switch (face)
+            {
+                case Rasterizer::cull::front          : return GL_FRONT;
+                case Rasterizer::cull::front_and_back : return GL_FRONT_AND_BACK;
+                default                               : return GL_BACK;
+            }
+        }
+
+        class Hasher
+        {
+            public:
+            void mix(std::uint64_t  value) noexcept
+            {
+                //FNV-1a
+                _hash ^= value;
+                _hash *= 1099511628211ull;
+            }
+
+            void mix(float  value) noexcept
+            {
+                auto bits = std::uint32_t{};
+                std::memcpy(&bits, &value, sizeof(bits));
+                mix(std::uint64_t{bits});
+            }
+
+            template <class enum_type, class = std::enable_if_t<std::is_enum_v<enum_type>>>
+            void mix(enum_type  value) noexcept { mix(static_cast<std::uint64_t>(value)); }
+
+            void mix(const void*  ptr) noexcept { mix(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(ptr))); }
+
+            [[nodiscard]] auto value() const noexcept -> std::size_t { return static_cast<std::size_t>(_hash); }
+
+            private:
+            std::uint64_t   _hash = 14695981039346656037ull;
+        };
+
+        void apply_blend(const pipeline::BlendState  &blend)
+        {
+            StateCache::get_instance().set_capability(GL_BLEND, blend.enable);
+            glBlendFuncSeparate(to_glType(blend.color_source), to_glType(blend.color_destination),
+                                to_glType(blend.alpha_source), to_glType(blend.alpha_destination));
+            glBlendColor(blend.color[0], blend.color[1], blend.color[2], blend.color[3]);
+        }
+
+        void apply_depth(const pipeline::DepthState  &depth)
+        {
+            StateCache::get_instance().set_capability(GL_DEPTH_TEST, depth.test);
+            glDepthMask(depth.write ? GL_TRUE : GL_FALSE);
+            glDepthFunc(to_glType(depth.function));
+        }
+
+        void apply_stencil(const pipeline::StencilState  &stencil)
+        {
+            StateCache::get_instance().set_capability(GL_STENCIL_TEST, stencil.test);
+            glStencilFunc(to_glType(stencil.function), stencil.reference, stencil.read_mask);
+            glStencilMask(stencil.write_mask);
+            glStencilOp(to_glStencilOp(stencil.stencil_fail), to_glStencilOp(stencil.depth_fail), to_glStencilOp(stencil.pass));
+        }
+
+        void apply_raster(const pipeline::RasterState  &raster)
+        {
+            auto &cache = StateCache::get_instance();
+            cache.set_capability(GL_CULL_FACE, raster.cull);
+            cache.set_capability(GL_SCISSOR_TEST, raster.scissor_test);
+            glCullFace(to_glCullFace(raster.cull_face));
+            glFrontFace(raster.front_face == Rasterizer::direction::counter_clockwise ? GL_CCW : GL_CW);
+            Rasterizer::get_instance().set_polygonMode(raster.polygon_mode);
+        }
+    }
+
+    namespace pipeline
+    {
+        auto operator==(const BlendState  &lhs, const BlendState  &rhs) noexcept -> bool
+        {
+            return lhs.enable == rhs.enable &&
+                   lhs.color_source == rhs.color_source && lhs.color_destination == rhs.color_destination &&
+                   lhs.alpha_source == rhs.alpha_source && lhs.alpha_destination == rhs.alpha_destination &&
+                   lhs.color == rhs.color;
+        }
+
+        auto operator==(const DepthState  &lhs, const DepthState  &rhs) noexcept -> bool
+        {
+            return lhs.test == rhs.test && lhs.write == rhs.write && lhs.function == rhs.function;
+        }
+
+        auto operator==(const StencilState  &lhs, const StencilState  &rhs) noexcept -> bool
+        {
+            return lhs.test == rhs.test && lhs.function == rhs.function && lhs.reference == rhs.reference &&
+                   lhs.read_mask == rhs.read_mask && lhs.write_mask == rhs.write_mask &&
+                   lhs.stencil_fail == rhs.stencil_fail && lhs.depth_fail == rhs.depth_fail && lhs.pass == rhs.pass;
+        }
+
+        auto operator==(const RasterState  &lhs, const RasterState  &rhs) noexcept -> bool
+        {
+            return lhs.cull == rhs.cull && lhs.cull_face == rhs.cull_face && lhs.front_face == rhs.front_face &&
+                   lhs.polygon_mode == rhs.polygon_mode && lhs.scissor_test == rhs.scissor_test;
+        }
+
+        auto operator==(const Description  &lhs, const Description  &rhs) noexcept -> bool
+        {
+            return lhs.shader == rhs.shader && lhs.vertex_layout == rhs.vertex_layout &&
+                   lhs.blend == rhs.blend && lhs.depth == rhs.depth && lhs.stencil == rhs.stencil && lhs.raster == rhs.raster;
+        }
+
+        auto hash(const Description  &description) noexcept -> std::size_t
+        {
+            auto h = Hasher{};
+            h.mix(static_cast<const void*>(description.shader));
+            h.mix(static_cast<const void*>(description.vertex_layout));
+
+            const auto &blend = description.blend;
+            h.mix(std::uint64_t{blend.enable});
+            h.mix(blend.color_source);
+            h.mix(blend.color_destination);
+            h.mix(blend.alpha_source);
+            h.mix(blend.alpha_destination);
+            for(auto c : blend.color) {
+                h.mix(c);
+            }
+
+            const auto &depth = description.depth;
+            h.mix(std::uint64_t{depth.test});
+            h.mix(std::uint64_t{depth.write});
+            h.mix(depth.function);
+
+            const auto &stencil = description.stencil;
+            h.mix(std::uint64_t{stencil.test});
+            h.mix(stencil.function);
+            h.mix(static_cast<std::uint64_t>(stencil.reference));
+            h.mix(std::uint64_t{stencil.read_mask});
+            h.mix(std::uint64_t{stencil.write_mask});
+            h.mix(stencil.stencil_fail);
+            h.mix(stencil.depth_fail);
+            h.mix(stencil.pass);
+
+            const auto &raster = description.raster;
+            h.mix(std::uint64_t{raster.cull});
+            h.mix(raster.cull_face);
+            h.mix(raster.front_face);
+            h.mix(raster.polygon_mode);
+            h.mix(std::uint64_t{raster.scissor_test});
+
+            return h.value();
+        }
+    }
+
+    PipelineState::PipelineState(const pipeline::Description  &description, std::size_t  hash, std::uint32_t  id)
+        :_description{description}
+        ,_hash{hash}
+        ,_id{id}
+    {}
+
+    auto PipelineState::description() const noexcept -> const pipeline::Description&
+    {
+        return _description;
+    }
+
+    auto PipelineState::hash() const noexcept -> std::size_t
+    {
+        return _hash;
+    }
+
+    auto PipelineState::id() const noexcept -> std::uint32_t
+    {
+        return _id;
+    }
+
+    PipelineCache&  PipelineCache::get_instance()
+    {
+        static PipelineCache instance;
+        return instance;
+    }
+
+    auto PipelineCache::intern(const pipeline::Description  &description) -> const PipelineState&
+    {
+        const auto key = pipeline::hash(description);
+        auto &bucket = _states[key];
+        for(auto &state : bucket) {
+            if(state->description() == description) {
+                return *state;
+            }
+        }
+        bucket.push_back(std::unique_ptr<PipelineState>{ new PipelineState{description, key, _next_id++} });
+        return *bucket.back();
+    }
+
+    void PipelineCache::apply(const PipelineState  &state)
+    {
+        const auto &next = state.description();
+
+        if(next.shader) {
+            next.shader->use();
+        }
+        if(next.vertex_layout) {
+            next.vertex_layout->bind();
+        }
+
+        if(_current == &state) {
+            return;
+        }
+
+        if(_current == nullptr)
+        {
+            apply_blend(next.blend);
+            apply_depth(next.depth);
+            apply_stencil(next.stencil);
+            apply_raster(next.raster);
+            _current = &state;
+            return;
+        }
+
+        const auto &last = _current->description();
+        if(!(next.blend == last.blend))
+        {
+            if(next.blend.enable != last.blend.enable)
+                StateCache::get_instance().set_capability(GL_BLEND, next.blend.enable);
+            if(next.blend.color_source != last.blend.color_source || next.blend.color_destination != last.blend.color_destination ||
+               next.blend.alpha_source != last.blend.alpha_source || next.blend.alpha_destination != last.blend.alpha_destination)
+                glBlendFuncSeparate(to_glType(next.blend.color_source), to_glType(next.blend.color_destination),
+                                    to_glType(next.blend.alpha_source), to_glType(next.blend.alpha_destination));
+            if(next.blend.color != last.blend.color)
+                glBlendColor(next.blend.color[0], next.blend.color[1], next.blend.color[2], next.blend.color[3]);
+        }
+
+        if(!(next.depth == last.depth))
+        {
+            if(next.depth.test != last.depth.test)
+                StateCache::get_instance().set_capability(GL_DEPTH_TEST, next.depth.test);
+            if(next.depth.write != last.depth.write)
+                glDepthMask(next.depth.write ? GL_TRUE : GL_FALSE);
+            if(next.depth.function != last.depth.function)
+                glDepthFunc(to_glType(next.depth.function));
+        }
+
+        if(!(next.stencil == last.stencil))
+        {
+            const auto &s = next.stencil;
+            const auto &l = last.stencil;
+            if(s.test != l.test)
+                StateCache::get_instance().set_capability(GL_STENCIL_TEST, s.test);
+            if(s.function != l.function || s.reference != l.reference || s.read_mask != l.read_mask)
+                glStencilFunc(to_glType(s.function), s.reference, s.read_mask);
+            if(s.write_mask != l.write_mask)
+                glStencilMask(s.write_mask);
+            if(s.stencil_fail != l.stencil_fail || s.depth_fail != l.depth_fail || s.pass != l.pass)
+                glStencilOp(to_glStencilOp(s.stencil_fail), to_glStencilOp(s.depth_fail), to_glStencilOp(s.pass));
+        }
+
+        if(!(next.raster == last.raster))
+        {
+            const auto &r = next.raster;
+            const auto &l = last.raster;
+            if(r.cull != l.cull)
+                StateCache::get_instance().set_capability(GL_CULL_FACE, r.cull);
+            if(r.scissor_test != l.scissor_test)
+                StateCache::get_instance().set_capability(GL_SCISSOR_TEST, r.scissor_test);
+            if(r.cull_face != l.cull_face)
+                glCullFace(to_glCullFace(r.cull_face));
+            if(r.front_face != l.front_face)
+                glFrontFace(r.front_face == Rasterizer::direction::counter_clockwise ? GL_CCW : GL_CW);
+            if(r.polygon_mode != l.polygon_mode)
+                Rasterizer::get_instance().set_polygonMode(r.polygon_mode);
+        }
+
+        _current = &state;
+    }
+
+    void PipelineCache::reset() noexcept
+    {
+        _current = nullptr;
+    }
+
+    void PipelineCache::clear() noexcept
+    {
+        _states.clear();
+        _next_id = 0;
+        _current = nullptr;
+    }
+
+    auto PipelineCache::size() const noexcept -> std::size_t
+    {
+        return _next_id;
+    }
+
+    auto PipelineCache::last_applied() const noexcept -> const PipelineState*
+    {
+        return _current;
+    }
+}
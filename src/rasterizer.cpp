@@ -1,6 +1,7 @@
 
 
 #include "glcore/rasterizer.hpp"
+#include "glcore/state_cache.hpp"
 #include "platform/gl.hpp"
 #include "utils/gl_conversions.hpp"
 
@@ -59,15 +60,15 @@ namespace nitros::glcore
     }
 
     void Rasterizer::enable(Rasterizer::capability type){
-        glEnable(to_glType(type));
+        StateCache::get_instance().set_capability(to_glType(type), true);
     }
 
     void Rasterizer::disable(Rasterizer::capability type){
-        glDisable(to_glType(type));
+        StateCache::get_instance().set_capability(to_glType(type), false);
     }
 
     bool Rasterizer::is_enabled(Rasterizer::capability type){
-        return glIsEnabled(to_glType(type));
+        return StateCache::get_instance().get_capability(to_glType(type));
     }
 
     void Rasterizer::set_blend_color(const utils::vec4f &color){
@@ -75,7 +76,7 @@ namespace nitros::glcore
     }
 
     void Rasterizer::view_port(const std::uint32_t  &x, const std::uint32_t  &y, const std::size_t  &width, const std::size_t  &height){
-        glViewport(gsl::narrow_cast<GLint>(x), gsl::narrow_cast<GLint>(y), gsl::narrow_cast<GLsizei>(width), gsl::narrow_cast<GLsizei>(height));
+        StateCache::get_instance().viewport(gsl::narrow_cast<GLint>(x), gsl::narrow_cast<GLint>(y), gsl::narrow_cast<GLsizei>(width), gsl::narrow_cast<GLsizei>(height));
     }
 
 
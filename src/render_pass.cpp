@@ -0,0 +1,76 @@
+
+
+#include "glcore/render_pass.hpp"
+#include "glcore/state_cache.hpp"
+#include "platform/gl.hpp"
+#include "utils/gl_conversions.hpp"
+
+namespace nitros::glcore
+{
+    RenderPass::RenderPass(const FrameBuffer*  framebuffer, const std::optional<ViewDim>  &viewport, const PipelineState*  pipeline)
+        :_framebuffer{framebuffer}
+        ,_previous_draw_framebuffer{0}
+        ,_previous_read_framebuffer{0}
+        ,_previous_viewport{}
+        ,_viewport_changed{viewport.has_value()}
+        ,_previous_pipeline{PipelineCache::get_instance().last_applied()}
+    {
+        auto &cache = StateCache::get_instance();
+        _previous_draw_framebuffer = cache.get_framebuffer(GL_DRAW_FRAMEBUFFER);
+        _previous_read_framebuffer = cache.get_framebuffer(GL_READ_FRAMEBUFFER);
+
+        if(_framebuffer)
+            _framebuffer->bind();
+        else
+            FrameBuffer::bind_default();
+
+        if(viewport)
+        {
+            _previous_viewport = cache.get_viewport();
+            ViewPort::dimension(*viewport);
+        }
+
+        if(pipeline) {
+            PipelineCache::get_instance().apply(*pipeline);
+        }
+    }
+
+    RenderPass::~RenderPass()
+    {
+        auto &cache = StateCache::get_instance();
+
+        if(_previous_pipeline) {
+            PipelineCache::get_instance().apply(*_previous_pipeline);
+        }
+        //After the pipeline, applying it binds its vertex layout.
+        //Buffers written after the pass mustn't change the element binding of the last VertexArray
+        cache.bind_vertex_array(0);
+        if(_viewport_changed) {
+            cache.viewport(_previous_viewport[0], _previous_viewport[1], _previous_viewport[2], _previous_viewport[3]);
+        }
+        if(_previous_draw_framebuffer == _previous_read_framebuffer)
+        {
+            cache.bind_framebuffer(GL_FRAMEBUFFER, _previous_draw_framebuffer);
+        }
+        else
+        {
+            cache.bind_framebuffer(GL_DRAW_FRAMEBUFFER, _previous_draw_framebuffer);
+            cache.bind_framebuffer(GL_READ_FRAMEBUFFER, _previous_read_framebuffer);
+        }
+    }
+
+    void RenderPass::set_pipeline(const PipelineState  &pipeline)
+    {
+        PipelineCache::get_instance().apply(pipeline);
+    }
+
+    void RenderPass::bind_texture(const render::TextureBinding  &binding)
+    {
+        StateCache::get_instance().bind_texture_unit(binding.unit, to_glType(binding.target), binding.id);
+    }
+
+    auto RenderPass::get_framebuffer() const noexcept -> const FrameBuffer*
+    {
+        return _framebuffer;
+    }
+}
@@ -0,0 +1,239 @@
+
+
+#include "glcore/render_queue.hpp"
+#include "glcore/rasterizer.hpp"
+#include "glcore/state_cache.hpp"
+#include "utils/gl_conversions.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+
+namespace nitros::glcore
+{
+    namespace
+    {
+        template <class map_type, class key_type>
+        auto dense_id(map_type  &ids, const key_type  &key) -> std::uint64_t
+        {
+            auto [itr, inserted] = ids.try_emplace(key, gsl::narrow_cast<std::uint32_t>(ids.size()));
+            return itr->second;
+        }
+
+        auto texture_set_hash(std::vector<render::TextureBinding>  textures) -> std::uint64_t
+        {
+            std::sort(textures.begin(), textures.end(), [](auto &lhs, auto &rhs) { return lhs.unit < rhs.unit; });
+
+            //FNV-1a, a collision only merges two texture groups
+            auto hash = std::uint64_t{14695981039346656037ull};
+            auto mix  = [&hash](std::uint64_t  value) {
+                hash ^= value;
+                hash *= 1099511628211ull;
+            };
+            for(auto &binding : textures) {
+                mix(binding.unit);
+                mix(static_cast<std::uint64_t>(binding.target));
+                mix(binding.id);
+            }
+            return hash;
+        }
+
+        //Positive floats order like their bits, the upper 16 bits keep the exponent and 7 mantissa bits
+        auto depth_bits(float  depth) -> std::uint64_t
+        {
+            depth = std::max(depth, 0.f);
+            auto bits = std::uint32_t{};
+            std::memcpy(&bits, &depth, sizeof(bits));
+            return bits >> 16u;
+        }
+
+        auto raster_bits(const render::RasterState  &raster) -> std::uint64_t
+        {
+            return (raster.blend ? 1u : 0u) | (raster.depth_test ? 2u : 0u) | (raster.cull_face ? 4u : 0u) | (raster.scissor_test ? 8u : 0u);
+        }
+
+        constexpr auto bits(std::uint64_t  value, std::uint32_t  width, std::uint32_t  shift) -> std::uint64_t
+        {
+            return (value & ((std::uint64_t{1} << width) - 1)) << shift;
+        }
+
+        void bind_texture(const render::TextureBinding  &binding)
+        {
+            StateCache::get_instance().bind_texture_unit(binding.unit, to_glType(binding.target), binding.id);
+        }
+
+        void set_capability(Rasterizer  &rasterizer, Rasterizer::capability  type, bool enable)
+        {
+            if(enable)
+                rasterizer.enable(type);
+            else
+                rasterizer.disable(type);
+        }
+    }
+
+    void RenderQueue::push(render::DrawItem  item)
+    {
+        if(item.shader == nullptr || item.vertex_array == nullptr) {
+            throw std::invalid_argument("Draw Item needs a Shader and a VertexArray");
+        }
+        if(item.layer > render::DrawItem::max_layer) {
+            throw std::out_of_range("Draw Item layer exceeds the 4 layer bits of the sort key");
+        }
+
+        const auto framebuffer  = dense_id(_framebuffer_ids, static_cast<const void*>(item.framebuffer));
+        const auto shader       = dense_id(_shader_ids, static_cast<const void*>(item.shader));
+        const auto vertex_array = dense_id(_vertex_array_ids, static_cast<const void*>(item.vertex_array));
+        const auto textures     = dense_id(_texture_set_ids, texture_set_hash(item.textures));
+        const auto raster       = raster_bits(item.raster);
+        const auto depth        = depth_bits(item.depth);
+
+        auto key = bits(item.layer, 4, 60) | bits(framebuffer, 6, 54);
+        if(item.translucent)
+        {
+            key |= bits(1, 1, 53) | bits(0xFFFFu - depth, 16, 37) | bits(shader, 10, 27) |
+                   bits(raster, 4, 23) | bits(textures, 12, 11) | bits(vertex_array, 11, 0);
+        }
+        else
+        {
+            key |= bits(shader, 10, 43) | bits(raster, 4, 39) | bits(textures, 12, 27) |
+                   bits(vertex_array, 11, 16) | bits(depth, 16, 0);
+        }
+
+        _keys.push_back(key);
+        _items.push_back(std::move(item));
+    }
+
+    void RenderQueue::sort()
+    {
+        const auto count = _items.size();
+        _order.resize(count);
+        _scratch.resize(count);
+        for(auto i = std::size_t{0}; i < count; i++) {
+            _order[i] = gsl::narrow_cast<std::uint32_t>(i);
+        }
+
+        //Least significant digit radix sort of the indices, 8 bits per pass, stable so equal keys keep the push order
+        for(auto shift = 0u; shift < 64u; shift += 8u)
+        {
+            auto histogram = std::array<std::size_t, 257>{};
+            for(auto i : _order) {
+                histogram[((_keys[i] >> shift) & 0xFFu) + 1]++;
+            }
+            //Every key has the same digit, the pass wouldn't move anything
+            if(std::any_of(histogram.begin() + 1, histogram.end(), [count](auto c) { return c == count; })) {
+                continue;
+            }
+            for(auto d = 1u; d < histogram.size(); d++) {
+                histogram[d] += histogram[d - 1];
+            }
+            for(auto i : _order) {
+                _scratch[histogram[(_keys[i] >> shift) & 0xFFu]++] = i;
+            }
+            std::swap(_order, _scratch);
+        }
+    }
+
+    void RenderQueue::submit()
+    {
+        _stats = Stats{};
+        sort();
+
+        auto& rasterizer = Rasterizer::get_instance();
+
+        const FrameBuffer*  framebuffer  = nullptr;
+        Shader*             shader       = nullptr;
+        const VertexArray*  vertex_array = nullptr;
+        auto raster   = render::RasterState{};
+        auto textures = std::map<std::uint32_t, std::uint32_t>{};
+        auto first    = true;
+
+        for(auto i : _order)
+        {
+            auto &item = _items[i];
+
+            if(first || item.framebuffer != framebuffer)
+            {
+                if(item.framebuffer)
+                    item.framebuffer->bind();
+                else
+                    FrameBuffer::bind_default();
+                framebuffer = item.framebuffer;
+                _stats.framebuffer_changes++;
+            }
+
+            if(item.shader != shader)
+            {
+                item.shader->use();
+                shader = item.shader;
+                _stats.shader_changes++;
+            }
+
+            if(first || raster_bits(item.raster) != raster_bits(raster))
+            {
+                if(first || item.raster.blend != raster.blend)
+                    set_capability(rasterizer, Rasterizer::capability::blend, item.raster.blend);
+                if(first || item.raster.depth_test != raster.depth_test)
+                    set_capability(rasterizer, Rasterizer::capability::depth_test, item.raster.depth_test);
+                if(first || item.raster.cull_face != raster.cull_face)
+                    set_capability(rasterizer, Rasterizer::capability::cull_face, item.raster.cull_face);
+                if(first || item.raster.scissor_test != raster.scissor_test)
+                    set_capability(rasterizer, Rasterizer::capability::scissor_test, item.raster.scissor_test);
+                raster = item.raster;
+                _stats.raster_changes++;
+            }
+
+            for(auto &binding : item.textures)
+            {
+                auto itr = textures.find(binding.unit);
+                if(itr == textures.end() || itr->second != binding.id)
+                {
+                    bind_texture(binding);
+                    textures[binding.unit] = binding.id;
+                    _stats.texture_changes++;
+                }
+            }
+
+            if(item.uniforms) {
+                item.uniforms(*item.shader);
+            }
+
+            if(item.vertex_array != vertex_array)
+            {
+                item.vertex_array->bind();
+                vertex_array = item.vertex_array;
+                _stats.vertex_array_changes++;
+            }
+
+            if(item.instance_count == 1)
+                item.vertex_array->draw();
+            else
+                item.vertex_array->draw_instanced(item.instance_count);
+
+            _stats.draws++;
+            first = false;
+        }
+
+        clear();
+    }
+
+    void RenderQueue::clear()
+    {
+        _items.clear();
+        _keys.clear();
+        _framebuffer_ids.clear();
+        _shader_ids.clear();
+        _vertex_array_ids.clear();
+        _texture_set_ids.clear();
+    }
+
+    auto RenderQueue::size() const noexcept -> std::size_t
+    {
+        return _items.size();
+    }
+
+    auto RenderQueue::last_stats() const noexcept -> const Stats&
+    {
+        return _stats;
+    }
+}
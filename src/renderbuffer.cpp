@@ -3,12 +3,27 @@
 #include "glcore/renderbuffer.hpp"
 #include "platform/gl.hpp"
 #include "utils/gl_conversions.hpp"
+#include "glcore/object_pool.hpp"
+#include "glcore/memory_tracker.hpp"
 
 namespace nitros::glcore 
 {
+    template <texture::type T_>
+    auto get_poolKey(const utils::ImageMetaData  &meta_data) -> pool::Key
+    {
+        return pool::Key{ pool::kind::renderbuffer, GL_RENDERBUFFER, static_cast<std::uint32_t>(to_internal_glFormat<T_>(meta_data.format)),
+                          meta_data.size.width, meta_data.size.height, 1 };
+    }
+
     template <texture::type T_>
     RenderBuffer<T_>::RenderBuffer(const utils::ImageMetaData  &meta_data)
     {
+        if(auto id = ObjectPool::get_instance().acquire(get_poolKey<T_>(meta_data))) {
+            _id = *id;
+            _meta_data = std::make_unique<utils::ImageMetaData>(meta_data);
+            MemoryTracker::get_instance().record(memory::resource::renderbuffer, _id, meta_data.step * meta_data.size.height);
+            return;
+        }
     #if OPENGL_CORE >= 40500
         glCreateRenderbuffers(1, &_id);
     #else
@@ -19,6 +34,11 @@ namespace nitros::glcore
 
     template <texture::type T_>
     RenderBuffer<T_>::~RenderBuffer() {
+        if(_meta_data && _meta_data->size.width > 0 && _meta_data->size.height > 0 &&
+           ObjectPool::get_instance().release(get_poolKey<T_>(*_meta_data), _id, _meta_data->step * _meta_data->size.height)) {
+            return;
+        }
+        MemoryTracker::get_instance().erase(memory::resource::renderbuffer, _id);
         glDeleteRenderbuffers(1, &_id);
     }
 
@@ -32,6 +52,7 @@ namespace nitros::glcore
         glRenderbufferStorage(GL_RENDERBUFFER, to_internal_glFormat<T_>(meta_data.format), meta_data.size.width, meta_data.size.height);
     #endif
         _meta_data = std::make_unique<utils::ImageMetaData>(meta_data);
+        MemoryTracker::get_instance().record(memory::resource::renderbuffer, _id, meta_data.step * meta_data.size.height);
     }
 
     template <texture::type T_>
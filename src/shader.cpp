@@ -1,8 +1,10 @@
 
 
 #include "glcore/shader.h"
+#include "glcore/state_cache.hpp"
 #include "platform/gl.hpp"
 #include <glm/gtc/type_ptr.hpp>
+#include <utility>
 #include "logger.hpp"
 
 namespace nitros::glcore
@@ -34,6 +36,11 @@ namespace nitros::glcore
                     pgms.push_back(compile_tessellation_evaluation(stage.tess_evaluation));
                 }
             #endif
+            #if defined(OPENGL_CORE)
+                if(stage.compute.size() > 0){
+                    pgms.push_back(compile_compute(stage.compute));
+                }
+            #endif
 
                 const auto start = pgms.data();
                 
@@ -41,7 +48,7 @@ namespace nitros::glcore
 
                 if(!passed)
                 {
-                    log::Logger()->error("Failed shaders \n{} \n{} \n{} \n{} \n{}", stage.vertex, stage.fragment, stage.tess_control, stage.tess_evaluation, stage.geometry);
+                    log::Logger()->error("Failed shaders \n{} \n{} \n{} \n{} \n{} \n{}", stage.vertex, stage.fragment, stage.tess_control, stage.tess_evaluation, stage.geometry, stage.compute);
                 }
 
                 for(auto p : pgms)
@@ -109,6 +116,19 @@ namespace nitros::glcore
             }
         #endif
 
+        #if defined(OPENGL_CORE)
+            auto compile_compute(const std::string &pgm) -> std::uint32_t
+            {
+                const auto shader = glCreateShader(GL_COMPUTE_SHADER);
+                create_shader_check(shader, "Compute Shader Error");
+                const GLchar*  shader_code = pgm.c_str();
+
+                auto success = compiler_shader(shader, shader_code);
+                shader_log(shader, success);
+                return shader;
+            }
+        #endif
+
             auto create_program( const std::vector<std::uint32_t> pgms) -> std::pair<bool, std::uint32_t>
             {
                 auto program = glCreateProgram();
@@ -184,15 +204,36 @@ namespace nitros::glcore
         ,_owning{owning}
     {}
 
+    Shader::Shader(Shader &&other) noexcept
+        :program{other.program}
+        ,_owning{std::exchange(other._owning, false)}
+    {}
+
     Shader::~Shader()
     {
-        if(_owning)
+        if(_owning) {
+            StateCache::get_instance().forget_program(program);
             glDeleteProgram(program);
+        }
+    }
+
+    Shader& Shader::operator=(Shader&&  other) noexcept
+    {
+        if(this != &other)
+        {
+            if(_owning) {
+                StateCache::get_instance().forget_program(program);
+                glDeleteProgram(program);
+            }
+            program = other.program;
+            _owning = std::exchange(other._owning, false);
+        }
+        return *this;
     }
 
     void Shader::use() const
     {
-        glUseProgram(program);
+        StateCache::get_instance().use_program(program);
     }
 
     void Shader::set_uniform_matrix4fv(const std::string &name, const glm::mat4  &mat, bool transpose)
@@ -203,15 +244,11 @@ namespace nitros::glcore
     }
 
     std::uint32_t   Shader::get_current_shader(){
-        auto id = std::int32_t{0};
-        glGetIntegerv(GL_CURRENT_PROGRAM, &id);
-        return static_cast<std::uint32_t>(id);
+        return StateCache::get_instance().get_program();
     }
 
     Shader   Shader::get_current_shader_t(){
-        auto id = std::int32_t{0};
-        glGetIntegerv(GL_CURRENT_PROGRAM, &id);
-        return Shader{ static_cast<std::uint32_t>(id), false};
+        return Shader{ StateCache::get_instance().get_program(), false};
     }
 
     template <class type, std::size_t N> void Shader::set_uniform(const std::string &name, const std::array<type, N> &value)
@@ -2,9 +2,13 @@
 
 #include "glcore/staging_buffer.hpp"
 #include "glcore/commands.hpp"
+#include "glcore/memory_tracker.hpp"
+#include "glcore/state_cache.hpp"
 #include "./utils/gl_conversions.hpp"
 #include "./platform/gl.hpp"
 #include "./logger.hpp"
+#include <algorithm>
+#include <cstring>
 
 namespace nitros::glcore
 {
@@ -22,6 +26,7 @@ namespace nitros::glcore
 
     StageBufferWrite::~StageBufferWrite()
     {
+        MemoryTracker::get_instance().erase(memory::resource::staging, _id);
         glDeleteBuffers(1, &_id);
     }
 
@@ -48,6 +53,7 @@ namespace nitros::glcore
         glBufferData(GL_PIXEL_UNPACK_BUFFER, height * step, NULL, GL_STREAM_DRAW);
         auto map_buffer = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
 #endif
+        MemoryTracker::get_instance().record(memory::resource::staging, _id, height * step);
 
         if(map_buffer == NULL) {
             LOG_E("Staging Write buffer Map returns NULL");
@@ -96,7 +102,7 @@ namespace nitros::glcore
 #if OPENGL_CORE >= 40500
         glTextureSubImage2D(img_view.get_id(), img_view.get_level(), 0, 0, w, h, to_glFormat<T>(meta_data.format), to_glType(meta_data.format), 0);
 #else
-        glBindTexture(GL_TEXTURE_2D, img_view.get_id());
+        StateCache::get_instance().bind_texture(GL_TEXTURE_2D, img_view.get_id());
         glTexSubImage2D(GL_TEXTURE_2D, img_view.get_level(), 0, 0, w, h, to_glFormat<T>(meta_data.format), to_glType(meta_data.format), 0);
 #endif
         command::error();
@@ -153,6 +159,20 @@ namespace nitros::glcore
         }
     }
 
+    auto Fence::wait(std::chrono::nanoseconds  timeout) const -> bool
+    {
+        if(!_sync_ptr) {
+            return true;
+        }
+
+        auto status = glClientWaitSync(static_cast<GLsync>(_sync_ptr), GL_SYNC_FLUSH_COMMANDS_BIT, gsl::narrow_cast<GLuint64>(timeout.count()) );
+        if(status == GL_WAIT_FAILED) {
+            command::error();
+            return false;
+        }
+        return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+    }
+
 
     StageBufferRead::StageBufferRead()
         :GLobj{}
@@ -168,6 +188,7 @@ namespace nitros::glcore
 
     StageBufferRead::~StageBufferRead()
     {
+        MemoryTracker::get_instance().erase(memory::resource::staging, _id);
         glDeleteBuffers(1, &_id);
     }
 
@@ -181,6 +202,7 @@ namespace nitros::glcore
 
         glBindBuffer(GL_PIXEL_PACK_BUFFER, _id);
         glBufferData(GL_PIXEL_PACK_BUFFER, buf_size, NULL, GL_STREAM_COPY );
+        MemoryTracker::get_instance().record(memory::resource::staging, _id, buf_size);
 
 #if OPENGL_CORE >= 40500
         glGetTextureSubImage(
@@ -197,7 +219,7 @@ namespace nitros::glcore
             buf_size,
             NULL);
 #else
-        glBindTexture(GL_TEXTURE_2D, img_view.get_id());
+        StateCache::get_instance().bind_texture(GL_TEXTURE_2D, img_view.get_id());
         glGetTexImage(GL_TEXTURE_2D, 
                     img_view.get_level(),
                     to_glFormat<T>(meta_data.format),
@@ -269,6 +291,92 @@ namespace nitros::glcore
         return *_meta_data;
     }
 
+    BufferReadback::BufferReadback(const Buffer  &buffer)
+        :BufferReadback{buffer, 0, buffer.size_bytes()}
+    {}
+
+    BufferReadback::BufferReadback(const Buffer  &buffer, std::size_t  offset, std::size_t  length)
+        :GLobj{}
+        ,_size{length}
+        ,_fence{}
+    {
+        if(offset + length > buffer.size_bytes()) {
+            throw std::out_of_range("Read back range exceeds the Buffer size");
+        }
+
+#if OPENGL_CORE >= 40500
+        glCreateBuffers(1, &_id);
+        glNamedBufferStorage(_id, gsl::narrow_cast<GLsizeiptr>(std::max<std::size_t>(length, 1)), nullptr, GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT);
+        if(length > 0) {
+            glCopyNamedBufferSubData(buffer.get_id(), _id, offset, 0, length);
+        }
+#else
+        glGenBuffers(1, &_id);
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer.get_id());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, _id);
+        glBufferData(GL_COPY_WRITE_BUFFER, gsl::narrow_cast<GLsizeiptr>(length), nullptr, GL_STREAM_READ);
+        if(length > 0) {
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset, 0, length);
+        }
+#endif
+        command::error();
+        MemoryTracker::get_instance().record(memory::resource::staging, _id, length);
+        _fence = std::make_unique<Fence>();
+    }
+
+    BufferReadback::~BufferReadback()
+    {
+        MemoryTracker::get_instance().erase(memory::resource::staging, _id);
+        glDeleteBuffers(1, &_id);
+    }
+
+    auto BufferReadback::is_ready() const -> bool
+    {
+        return _fence->commands_complete();
+    }
+
+    auto BufferReadback::wait(std::chrono::nanoseconds  timeout) const -> bool
+    {
+        return _fence->wait(timeout);
+    }
+
+    void BufferReadback::get(gsl::span<std::uint8_t>  data) const
+    {
+        using namespace std::chrono_literals;
+
+        const auto size = std::min( gsl::narrow_cast<std::size_t>( data.size_bytes() ), _size );
+        if(size == 0) {
+            return;
+        }
+        if(!_fence->wait(1s)) {
+            LOG_W("Buffer read back is not complete, mapping waits for the GPU");
+        }
+
+#if OPENGL_CORE >= 40500
+        auto map_buffer = glMapNamedBufferRange(_id, 0, size, GL_MAP_READ_BIT);
+#else
+        glBindBuffer(GL_COPY_READ_BUFFER, _id);
+        auto map_buffer = glMapBufferRange(GL_COPY_READ_BUFFER, 0, size, GL_MAP_READ_BIT);
+#endif
+        if(map_buffer == NULL) {
+            command::error();
+            throw std::runtime_error("Buffer read back Map error");
+        }
+
+        std::memcpy(data.data(), map_buffer, size);
+
+#if OPENGL_CORE >= 40500
+        glUnmapNamedBuffer(_id);
+#else
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+#endif
+    }
+
+    auto BufferReadback::size() const noexcept -> std::size_t
+    {
+        return _size;
+    }
+
     template auto StageBufferRead::stage_data(texture::ImageView<texture::type::color>  &image) -> utils::Uptr<Fence>;
     template auto StageBufferRead::stage_data(texture::ImageView<texture::type::depth>  &image) -> utils::Uptr<Fence>;
     template auto StageBufferRead::stage_data(texture::ImageView<texture::type::depth_stencil>  &image) -> utils::Uptr<Fence>;
@@ -0,0 +1,340 @@
+
+
+#include "glcore/state_cache.hpp"
+#include "platform/gl.hpp"
+#include "logger.hpp"
+#include <limits>
+
+namespace nitros::glcore
+{
+    namespace
+    {
+        constexpr auto unknown = std::numeric_limits<std::uint32_t>::max();
+    }
+
+    StateCache::StateCache()
+        :_enabled{true}
+        ,_verify{false}
+        ,_program{unknown}
+        ,_vertex_array{unknown}
+        ,_draw_framebuffer{unknown}
+        ,_read_framebuffer{unknown}
+        ,_active_unit{unknown}
+        ,_textures{}
+        ,_capabilities{}
+        ,_viewport{}
+        ,_scissor{}
+        ,_viewport_known{false}
+        ,_scissor_known{false}
+        ,_stats{0, 0}
+    {}
+
+    StateCache&  StateCache::get_instance()
+    {
+        static StateCache instance;
+        return instance;
+    }
+
+    void StateCache::reset() noexcept
+    {
+        _program          = unknown;
+        _vertex_array     = unknown;
+        _draw_framebuffer = unknown;
+        _read_framebuffer = unknown;
+        _active_unit      = unknown;
+        _textures.clear();
+        _capabilities.clear();
+        _viewport_known = false;
+        _scissor_known  = false;
+    }
+
+    void StateCache::set_enabled(bool  enable) noexcept
+    {
+        _enabled = enable;
+        reset();
+    }
+
+    auto StateCache::is_enabled() const noexcept -> bool
+    {
+        return _enabled;
+    }
+
+    void StateCache::set_verify(bool  verify) noexcept
+    {
+        _verify = verify;
+    }
+
+    auto StateCache::is_verifying() const noexcept -> bool
+    {
+        return _verify;
+    }
+
+    auto StateCache::skip(bool  unchanged) noexcept -> bool
+    {
+        if(_enabled && unchanged) {
+            _stats.skipped++;
+            return true;
+        }
+        _stats.issued++;
+        return false;
+    }
+
+    void StateCache::use_program(std::uint32_t  program)
+    {
+        if(skip(_program == program)) {
+            return;
+        }
+        glUseProgram(program);
+        _program = program;
+    }
+
+    void StateCache::bind_vertex_array(std::uint32_t  vertex_array)
+    {
+        if(skip(_vertex_array == vertex_array)) {
+            return;
+        }
+        glBindVertexArray(vertex_array);
+        _vertex_array = vertex_array;
+    }
+
+    void StateCache::bind_framebuffer(std::uint32_t  target, std::uint32_t  framebuffer)
+    {
+        switch (target)
+        {
+            case GL_DRAW_FRAMEBUFFER:
+                if(skip(_draw_framebuffer == framebuffer)) {
+                    return;
+                }
+                _draw_framebuffer = framebuffer;
+                break;
+            case GL_READ_FRAMEBUFFER:
+                if(skip(_read_framebuffer == framebuffer)) {
+                    return;
+                }
+                _read_framebuffer = framebuffer;
+                break;
+            default:
+                if(skip(_draw_framebuffer == framebuffer && _read_framebuffer == framebuffer)) {
+                    return;
+                }
+                _draw_framebuffer = framebuffer;
+                _read_framebuffer = framebuffer;
+                break;
+        }
+        glBindFramebuffer(target, framebuffer);
+    }
+
+    void StateCache::active_texture(std::uint32_t  unit)
+    {
+        if(skip(_active_unit == unit)) {
+            return;
+        }
+        glActiveTexture(GL_TEXTURE0 + unit);
+        _active_unit = unit;
+    }
+
+    void StateCache::bind_texture(std::uint32_t  target, std::uint32_t  texture)
+    {
+        if(_active_unit == unknown)
+        {
+            //The unit of the binding isn't known, nothing can be remembered
+            _stats.issued++;
+            glBindTexture(target, texture);
+            return;
+        }
+
+        auto key = std::make_pair(_active_unit, target);
+        auto itr = _textures.find(key);
+        if(skip(itr != _textures.end() && itr->second == texture)) {
+            return;
+        }
+        glBindTexture(target, texture);
+        _textures[key] = texture;
+    }
+
+    void StateCache::bind_texture_unit(std::uint32_t  unit, std::uint32_t  target, std::uint32_t  texture)
+    {
+        auto key = std::make_pair(unit, target);
+        auto itr = _textures.find(key);
+        if(skip(itr != _textures.end() && itr->second == texture)) {
+            return;
+        }
+    #if OPENGL_CORE >= 40500
+        glBindTextureUnit(unit, texture);
+    #else
+        active_texture(unit);
+        glBindTexture(target, texture);
+    #endif
+        _textures[key] = texture;
+    }
+
+    void StateCache::set_capability(std::uint32_t  capability, bool  enable)
+    {
+        auto itr = _capabilities.find(capability);
+        if(skip(itr != _capabilities.end() && itr->second == enable)) {
+            return;
+        }
+        if(enable)
+            glEnable(capability);
+        else
+            glDisable(capability);
+        _capabilities[capability] = enable;
+    }
+
+    void StateCache::viewport(std::int32_t  x, std::int32_t  y, std::int32_t  width, std::int32_t  height)
+    {
+        const auto value = rect{x, y, width, height};
+        if(skip(_viewport_known && _viewport == value)) {
+            return;
+        }
+        glViewport(x, y, width, height);
+        _viewport = value;
+        _viewport_known = true;
+    }
+
+    void StateCache::scissor(std::int32_t  x, std::int32_t  y, std::int32_t  width, std::int32_t  height)
+    {
+        const auto value = rect{x, y, width, height};
+        if(skip(_scissor_known && _scissor == value)) {
+            return;
+        }
+        glScissor(x, y, width, height);
+        _scissor = value;
+        _scissor_known = true;
+    }
+
+    auto StateCache::get_program() -> std::uint32_t
+    {
+        if(_enabled && !_verify && _program != unknown) {
+            return _program;
+        }
+
+        auto id = std::int32_t{0};
+        glGetIntegerv(GL_CURRENT_PROGRAM, &id);
+        const auto program = static_cast<std::uint32_t>(id);
+
+        if(_verify && _program != unknown && _program != program) {
+            LOG_W("State Cache program {} differs from GL program {}", _program, program);
+        }
+        if(_enabled) {
+            _program = program;
+        }
+        return program;
+    }
+
+    auto StateCache::get_framebuffer(std::uint32_t  target) -> std::uint32_t
+    {
+        const auto read  = target == GL_READ_FRAMEBUFFER;
+        auto &framebuffer = read ? _read_framebuffer : _draw_framebuffer;
+        if(_enabled && !_verify && framebuffer != unknown) {
+            return framebuffer;
+        }
+
+        auto id = std::int32_t{0};
+        glGetIntegerv(read ? GL_READ_FRAMEBUFFER_BINDING : GL_DRAW_FRAMEBUFFER_BINDING, &id);
+        const auto bound = static_cast<std::uint32_t>(id);
+
+        if(_verify && framebuffer != unknown && framebuffer != bound) {
+            LOG_W("State Cache framebuffer {} differs from GL framebuffer {}", framebuffer, bound);
+        }
+        if(_enabled) {
+            framebuffer = bound;
+        }
+        return bound;
+    }
+
+    auto StateCache::get_capability(std::uint32_t  capability) -> bool
+    {
+        auto itr = _capabilities.find(capability);
+        const auto known = itr != _capabilities.end();
+        if(_enabled && !_verify && known) {
+            return itr->second;
+        }
+
+        const auto enabled = glIsEnabled(capability) == GL_TRUE;
+
+        if(_verify && known && itr->second != enabled) {
+            LOG_W("State Cache capability {:#x} differs from GL", capability);
+        }
+        if(_enabled) {
+            _capabilities[capability] = enabled;
+        }
+        return enabled;
+    }
+
+    auto StateCache::get_viewport() -> rect
+    {
+        if(_enabled && !_verify && _viewport_known) {
+            return _viewport;
+        }
+
+        auto value = rect{};
+        glGetIntegerv(GL_VIEWPORT, value.data());
+
+        if(_verify && _viewport_known && _viewport != value) {
+            LOG_W("State Cache viewport differs from GL");
+        }
+        if(_enabled) {
+            _viewport = value;
+            _viewport_known = true;
+        }
+        return value;
+    }
+
+    auto StateCache::get_scissor() -> rect
+    {
+        if(_enabled && !_verify && _scissor_known) {
+            return _scissor;
+        }
+
+        auto value = rect{};
+        glGetIntegerv(GL_SCISSOR_BOX, value.data());
+
+        if(_verify && _scissor_known && _scissor != value) {
+            LOG_W("State Cache scissor differs from GL");
+        }
+        if(_enabled) {
+            _scissor = value;
+            _scissor_known = true;
+        }
+        return value;
+    }
+
+    void StateCache::forget_program(std::uint32_t  program) noexcept
+    {
+        if(_program == program) {
+            _program = unknown;
+        }
+    }
+
+    void StateCache::forget_vertex_array(std::uint32_t  vertex_array) noexcept
+    {
+        if(_vertex_array == vertex_array) {
+            _vertex_array = 0;
+        }
+    }
+
+    void StateCache::forget_framebuffer(std::uint32_t  framebuffer) noexcept
+    {
+        if(_draw_framebuffer == framebuffer) {
+            _draw_framebuffer = 0;
+        }
+        if(_read_framebuffer == framebuffer) {
+            _read_framebuffer = 0;
+        }
+    }
+
+    void StateCache::forget_texture(std::uint32_t  texture) noexcept
+    {
+        for(auto &[key, bound] : _textures) {
+            if(bound == texture) {
+                bound = 0;
+            }
+        }
+    }
+
+    auto StateCache::stats() const noexcept -> const Stats&
+    {
+        return _stats;
+    }
+}
@@ -7,6 +7,9 @@
 #include <cstring>
 #include <cmath>
 #include "glcore/commands.hpp"
+#include "glcore/object_pool.hpp"
+#include "glcore/memory_tracker.hpp"
+#include "glcore/state_cache.hpp"
 #include <iostream>
 
 namespace nitros::glcore
@@ -160,6 +163,50 @@ namespace nitros::glcore
     template <class T>
     struct always_false : std::false_type {};
 
+    template <texture::type T_>
+    auto get_poolKey(texture::target  target, const utils::ImageMetaData  &meta_data, std::uint32_t  levels) -> pool::Key
+    {
+        return pool::Key{ pool::kind::texture, static_cast<std::uint32_t>(to_glType(target)), static_cast<std::uint32_t>(to_internal_glFormat<T_>(meta_data.format)),
+                          meta_data.size.width, meta_data.size.height, levels };
+    }
+
+    auto get_storageBytes(texture::target  target, const utils::ImageMetaData  &meta_data, std::uint32_t  levels) -> std::size_t
+    {
+        auto bytes = meta_data.step * meta_data.size.height * (target == texture::target::cube_map ? 6 : 1);
+        //The mip chain adds up to a third of the base level
+        return levels > 1 ? bytes + bytes / 3 : bytes;
+    }
+
+    //Parameters left by the previous owner of a pooled texture, the GL defaults
+    auto reset_parameters() -> texture::Parameters
+    {
+        using params = texture::Parameters;
+        auto reset = params{};
+        reset.add(
+            params::base_level{0},
+            params::max_level{1000},
+            params::min_lod{-1000.f},
+            params::max_lod{1000.f},
+            params::swizzle{params::swizzle_value{}},
+            params::wrap_r{params::wrap_params::repeat});
+    #if defined(OPENGL_CORE)
+        reset.add(params::border_color{utils::vec4f{0.f, 0.f, 0.f, 0.f}});
+    #endif
+        return reset;
+    }
+
+    template <class value_type>
+    auto same_value(const value_type  &lhs, const value_type  &rhs) -> bool
+    {
+        if constexpr(std::is_same_v<value_type, texture::Parameters::swizzle_value>) {
+            return lhs.red_channel == rhs.red_channel && lhs.green_channel == rhs.green_channel &&
+                   lhs.blue_channel == rhs.blue_channel && lhs.alpha_channel == rhs.alpha_channel;
+        }
+        else {
+            return lhs == rhs;
+        }
+    }
+
     template <texture::type T_>
     Texture<T_>::Texture(texture::target  target_, bool mipmap)
         :_target{target_}
@@ -180,6 +227,8 @@ namespace nitros::glcore
                     return std::make_unique<utils::ImageMetaData>( utils::ImgSize{0, 0}, utils::pixel::STENCIL8::value );
                 }
             }()}
+        ,_current_params{reset_parameters()}
+        ,_storage_levels{0}
     {
     #if OPENGL_CORE >= 40500
         glCreateTextures(to_glType(_target), 1, &_id);
@@ -213,12 +262,23 @@ namespace nitros::glcore
         ,_mip_map{mipmap}
         ,_params{std::make_unique<Parameters>()}
         ,_meta_data{std::make_unique<utils::ImageMetaData>(meta_data)}
+        ,_current_params{reset_parameters()}
+        ,_storage_levels{0}
     {
-    #if OPENGL_CORE >= 40500
-        glCreateTextures(to_glType(_target), 1, &_id);
-    #else
-        glGenTextures(1, &_id);
-    #endif
+        auto pooled_id = ObjectPool::get_instance().acquire(get_poolKey<T_>(_target, meta_data, current_mip_levels()));
+        if(pooled_id) {
+            _id = *pooled_id;
+            _storage_levels = current_mip_levels();
+            texture_parameters(reset_parameters());
+            MemoryTracker::get_instance().record(memory::resource::texture, _id, get_storageBytes(_target, meta_data, _storage_levels));
+        }
+        else {
+        #if OPENGL_CORE >= 40500
+            glCreateTextures(to_glType(_target), 1, &_id);
+        #else
+            glGenTextures(1, &_id);
+        #endif
+        }
 
         using f_min = Parameters::filter_min_params;
         using f_max = Parameters::filter_max_params;
@@ -238,12 +298,24 @@ namespace nitros::glcore
             }
         }
         texture_parameters(*_params);
-        alloc_storage(_target, *_meta_data, _mip_map);
+        if(!pooled_id) {
+            alloc_storage(_target, *_meta_data, _mip_map);
+        }
     }
 
     template <texture::type T_>
     Texture<T_>::~Texture()
     {
+        //A moved from Texture has no meta data, a Texture without storage isn't worth pooling.
+        //The key uses the levels of the storage, texture() may switch mip mapping without reallocating
+        if(_meta_data && _storage_levels > 0 && _meta_data->size.width > 0 && _meta_data->size.height > 0)
+        {
+            if(ObjectPool::get_instance().release(get_poolKey<T_>(_target, *_meta_data, _storage_levels), _id, get_storageBytes(_target, *_meta_data, _storage_levels))) {
+                return;
+            }
+        }
+        MemoryTracker::get_instance().erase(memory::resource::texture, _id);
+        StateCache::get_instance().forget_texture(_id);
         glDeleteTextures(1, &_id);
     }
 
@@ -515,10 +587,12 @@ namespace nitros::glcore
         glTextureStorage2D(_id, levels, to_internal_glFormat<type>(meta_data.format), width, height);
         _meta_data = std::make_unique<utils::ImageMetaData>(meta_data);
     #else
-        glBindTexture(to_glType(_target), _id);
+        StateCache::get_instance().bind_texture(to_glType(_target), _id);
         glTexStorage2D(to_glType(_target), levels, to_internal_glFormat<type>(meta_data.format), width, height);
         _meta_data = std::make_unique<utils::ImageMetaData>(meta_data);
     #endif
+        _storage_levels = gsl::narrow_cast<std::uint32_t>(levels);
+        MemoryTracker::get_instance().record(memory::resource::texture, _id, get_storageBytes(target, meta_data, _storage_levels));
         log::Logger()->debug("Allocating Texture Storage {} X {}",width, height);
     }
 
@@ -528,7 +602,7 @@ namespace nitros::glcore
     #if OPENGL_CORE >= 40500
         glTextureSubImage2D(_id, level, offset[0], offset[1], dim[0], dim[1], to_glFormat<type>(format), to_glType(format), data.data() );
     #else
-        glBindTexture(to_glType(_target), _id);
+        StateCache::get_instance().bind_texture(to_glType(_target), _id);
         glTexSubImage2D(to_glType(_target), level, offset[0], offset[1], dim[0], dim[1], to_glFormat<type>(format), to_glType(format), data.data());
     #endif
     }
@@ -554,7 +628,7 @@ namespace nitros::glcore
             std::make_pair( gsl::narrow_cast<std::int32_t>( GL_TEXTURE_CUBE_MAP_NEGATIVE_Z ), data[5] ),
         };
 
-        glBindTexture(to_glType(_target), _id);
+        StateCache::get_instance().bind_texture(to_glType(_target), _id);
 
         for(const auto & [tgt, tex] : image_pairs)
         {
@@ -582,7 +656,7 @@ namespace nitros::glcore
 
 #if OPENGL_CORE >= 40500
     template <texture::type T_>
-    auto Texture<T_>::current_texture_parameters() const -> texture::Parameters
+    auto Texture<T_>::query_texture_parameters() const -> texture::Parameters
     {
         auto params = Parameters{};
         auto param_vec = std::vector<texture::Parameters::var_t>{
@@ -686,7 +760,7 @@ namespace nitros::glcore
     }
 #else
     template <texture::type T_>
-    auto Texture<T_>::current_texture_parameters() const -> texture::Parameters
+    auto Texture<T_>::query_texture_parameters() const -> texture::Parameters
     {
         auto params = Parameters{};
         auto param_vec = std::vector<texture::Parameters::var_t>{
@@ -703,7 +777,7 @@ namespace nitros::glcore
             Parameters::wrap_r{}
         };
 
-        glBindTexture(to_glType(_target), _id);
+        StateCache::get_instance().bind_texture(to_glType(_target), _id);
 
         for(const auto& param : param_vec)
         {
@@ -798,6 +872,34 @@ namespace nitros::glcore
 
 #endif
 
+    template <texture::type T_>
+    auto Texture<T_>::current_texture_parameters() const -> texture::Parameters
+    {
+        if(!StateCache::get_instance().is_verifying()) {
+            return _current_params;
+        }
+
+        auto queried = query_texture_parameters();
+        for(const auto& [key, param] : queried._options)
+        {
+            auto itr = _current_params._options.find(key);
+            auto same = itr != _current_params._options.end() && std::visit([](auto&& lhs, auto&& rhs)
+            {
+                using L = std::decay_t<decltype(lhs)>;
+                using R = std::decay_t<decltype(rhs)>;
+                if constexpr(std::is_same_v<L, R>)
+                    return same_value(lhs.value, rhs.value);
+                else
+                    return false;
+            }, param, itr->second);
+
+            if(!same) {
+                LOG_W("Texture {} parameter {} differs from GL", _id, static_cast<int>(key));
+            }
+        }
+        return queried;
+    }
+
     template <texture::type T_>
     auto Texture<T_>::image_view(const std::uint32_t  &level) -> utils::Uptr<ImageView>
     {
@@ -809,44 +911,35 @@ namespace nitros::glcore
                 return {};
             }
 
-        #if OPENGL_CORE >= 40500
-            
-            auto width  = std::int32_t{};
-            auto height = std::int32_t{};
-        
-            glGetTextureLevelParameteriv(_id, level, GL_TEXTURE_WIDTH , &width);
-            glGetTextureLevelParameteriv(_id, level, GL_TEXTURE_HEIGHT, &height);
+            //Each level halves the size of the previous one, rounded down and at least 1
+            auto width  = gsl::narrow_cast<std::int32_t>( std::max(_meta_data->size.width  >> level, 1u) );
+            auto height = gsl::narrow_cast<std::int32_t>( std::max(_meta_data->size.height >> level, 1u) );
 
-            if( !(width > 0) || !(height > 0) ) {
-                return {};
-            }
-        #elif OPENGL_CORE >= 40300
-
-            auto width = std::int32_t{};
-            auto height = std::int32_t{};
-
-            glBindTexture(to_glType(_target), _id);
-
-            if (_target == texture::target::cube_map)
+        #if OPENGL_CORE >= 40300
+            if(StateCache::get_instance().is_verifying())
             {
-                glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, level, GL_TEXTURE_WIDTH, &width);
-                glGetTexLevelParameteriv(GL_TEXTURE_CUBE_MAP_POSITIVE_X, level, GL_TEXTURE_WIDTH, &height);
-            }
-            else 
-            {
-                glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
-                glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &height);
+                auto gl_width  = std::int32_t{};
+                auto gl_height = std::int32_t{};
+            #if OPENGL_CORE >= 40500
+                glGetTextureLevelParameteriv(_id, level, GL_TEXTURE_WIDTH , &gl_width);
+                glGetTextureLevelParameteriv(_id, level, GL_TEXTURE_HEIGHT, &gl_height);
+            #else
+                const auto level_target = _target == texture::target::cube_map ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : GL_TEXTURE_2D;
+                StateCache::get_instance().bind_texture(to_glType(_target), _id);
+                glGetTexLevelParameteriv(level_target, level, GL_TEXTURE_WIDTH, &gl_width);
+                glGetTexLevelParameteriv(level_target, level, GL_TEXTURE_HEIGHT, &gl_height);
+            #endif
+                if(gl_width != width || gl_height != height) {
+                    LOG_W("Texture {} level {} is {}x{} in GL, expected {}x{}", _id, level, gl_width, gl_height, width, height);
+                }
+                width  = gl_width;
+                height = gl_height;
             }
+        #endif
 
-            if (!(width > 0) || !(height > 0)) {
+            if( !(width > 0) || !(height > 0) ) {
                 return {};
             }
-            
-        #else
-            auto den = std::pow(2, level);
-            auto width  = gsl::narrow_cast<std::int32_t>( _meta_data->size.width/den );
-            auto height = gsl::narrow_cast<std::int32_t>( _meta_data->size.height/den );
-        #endif
 
             auto meta_data = utils::ImageMetaData{ { gsl::narrow_cast<std::uint32_t>(width), gsl::narrow_cast<std::uint32_t>(height) }, _meta_data->format };
             return std::make_unique<texture::ImageView<T_>>(*this, level, meta_data);
@@ -866,6 +959,9 @@ namespace nitros::glcore
     template <texture::type T_>
     void Texture<T_>::texture_parameters(const texture::Parameters  &params)
     {
+        for(const auto& [key , param] : params._options) {
+            _current_params._options[key] = param;
+        }
         for(const auto& [key , param] : params._options)
         {
             std::visit([&id = _id](auto&& args)
@@ -943,7 +1039,10 @@ namespace nitros::glcore
     template <texture::type T_>
     void Texture<T_>::texture_parameters(const texture::Parameters  &params)
     {
-        glBindTexture(to_glType(_target), _id);
+        for(const auto& [key , param] : params._options) {
+            _current_params._options[key] = param;
+        }
+        StateCache::get_instance().bind_texture(to_glType(_target), _id);
         for(const auto& [key , param] : params._options)
         {
             std::visit([id = to_glType(_target)](auto&& args)
@@ -1025,18 +1124,13 @@ namespace nitros::glcore
     template <texture::type T_>
     void Texture<T_>::bind() const
     {
-        glBindTexture(to_glType(_target), _id);
+        StateCache::get_instance().bind_texture(to_glType(_target), _id);
     }
 
     template <texture::type T_>
     void Texture<T_>::active_bind(int num) const
     {
-    #if OPENGL_CORE >= 40500
-        glBindTextureUnit(num, _id);
-    #else
-        glActiveTexture(GL_TEXTURE0 + num);
-        glBindTexture(to_glType(_target), _id);
-    #endif
+        StateCache::get_instance().bind_texture_unit(num, to_glType(_target), _id);
     }
 
     template <texture::type T_>
@@ -1144,7 +1238,7 @@ namespace nitros::glcore
 
         #elif OPENGL_CORE >= 40300
 
-            glBindTexture(to_glType(get_target()), _texture.get().get_id());
+            StateCache::get_instance().bind_texture(to_glType(get_target()), _texture.get().get_id());
 
             if (get_target() == texture::target::cube_map)
             {
@@ -1199,7 +1293,7 @@ namespace nitros::glcore
         }
         #elif OPENGL_CORE >= 40300
 
-        glBindTexture(to_glType(get_target()), _texture.get().get_id());
+        StateCache::get_instance().bind_texture(to_glType(get_target()), _texture.get().get_id());
 
         if (get_target() == texture::target::texture_2D)
         {
@@ -0,0 +1,135 @@
+
+#include "glcore/vertex_format.hpp"
+#include <cstring>
+
+namespace nitros::glcore
+{
+    namespace vertex_format
+    {
+        auto to_half(float value) noexcept -> buffer::half
+        {
+            auto bits = std::uint32_t{};
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            const auto sign     = static_cast<std::uint16_t>( (bits >> 16) & 0x8000u );
+            const auto exponent = static_cast<std::int32_t>( (bits >> 23) & 0xffu );
+            auto mantissa       = bits & 0x7fffffu;
+
+            //Inf and NaN
+            if(exponent == 0xff) {
+                return { static_cast<std::uint16_t>( sign | 0x7c00u | (mantissa ? 0x200u : 0u) ) };
+            }
+
+            const auto half_exponent = exponent - 127 + 15;
+            if(half_exponent >= 0x1f) {
+                return { static_cast<std::uint16_t>( sign | 0x7c00u ) };
+            }
+
+            //Subnormal half or zero
+            if(half_exponent <= 0) {
+                if(half_exponent < -10) {
+                    return { sign };
+                }
+                mantissa |= 0x800000u;
+                const auto shift = static_cast<std::uint32_t>( 14 - half_exponent );
+                auto half_mantissa = mantissa >> shift;
+                //Round to nearest even
+                const auto round_bit = 1u << (shift - 1);
+                if( (mantissa & round_bit) && ( (mantissa & (round_bit - 1u)) || (half_mantissa & 1u) ) ) {
+                    ++half_mantissa;
+                }
+                return { static_cast<std::uint16_t>( sign | half_mantissa ) };
+            }
+
+            auto half_bits = static_cast<std::uint32_t>( sign ) | ( static_cast<std::uint32_t>(half_exponent) << 10 ) | ( mantissa >> 13 );
+            //Round to nearest even, a carry into the exponent rounds up to the next power of two or to infinity
+            if( (mantissa & 0x1000u) && ( (mantissa & 0x2fffu) ) ) {
+                ++half_bits;
+            }
+            return { static_cast<std::uint16_t>( half_bits ) };
+        }
+
+        auto from_half(buffer::half  value) noexcept -> float
+        {
+            const auto sign     = static_cast<std::uint32_t>( value.bits & 0x8000u ) << 16;
+            auto exponent       = static_cast<std::uint32_t>( (value.bits >> 10) & 0x1fu );
+            auto mantissa       = static_cast<std::uint32_t>( value.bits & 0x3ffu );
+
+            auto bits = std::uint32_t{};
+            if(exponent == 0x1f) {
+                bits = sign | 0x7f800000u | (mantissa << 13);
+            }
+            else if(exponent == 0) {
+                if(mantissa == 0) {
+                    bits = sign;
+                }
+                else {
+                    //Normalize the subnormal half
+                    exponent = 127 - 15 + 1;
+                    while( (mantissa & 0x400u) == 0 ) {
+                        mantissa <<= 1;
+                        --exponent;
+                    }
+                    mantissa &= 0x3ffu;
+                    bits = sign | (exponent << 23) | (mantissa << 13);
+                }
+            }
+            else {
+                bits = sign | ( (exponent + 127 - 15) << 23 ) | (mantissa << 13);
+            }
+
+            auto result = float{};
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        auto pack_2_10_10_10(const utils::vec4f  &value) noexcept -> buffer::packed_2_10_10_10
+        {
+            auto snorm = [](float v, float max_value, std::uint32_t mask) -> std::uint32_t {
+                const auto q = static_cast<std::int32_t>( std::lround( std::clamp(v, -1.0f, 1.0f) * max_value ) );
+                return static_cast<std::uint32_t>(q) & mask;
+            };
+
+            const auto x = snorm(value[0], 511.0f, 0x3ffu);
+            const auto y = snorm(value[1], 511.0f, 0x3ffu);
+            const auto z = snorm(value[2], 511.0f, 0x3ffu);
+            const auto w = snorm(value[3], 1.0f, 0x3u);
+
+            return { x | (y << 10) | (z << 20) | (w << 30) };
+        }
+
+        auto unpack_2_10_10_10(buffer::packed_2_10_10_10  value) noexcept -> utils::vec4f
+        {
+            auto snorm = [](std::uint32_t bits, std::uint32_t width, float max_value) -> float {
+                const auto shift = 32 - width;
+                const auto v = static_cast<std::int32_t>( bits << shift ) >> shift;
+                return std::max( static_cast<float>(v) / max_value, -1.0f );
+            };
+
+            return {
+                snorm( value.bits        & 0x3ffu, 10, 511.0f),
+                snorm((value.bits >> 10) & 0x3ffu, 10, 511.0f),
+                snorm((value.bits >> 20) & 0x3ffu, 10, 511.0f),
+                snorm((value.bits >> 30) & 0x3u,    2, 1.0f)
+            };
+        }
+
+        auto pack_2_10_10_10(const std::vector<utils::vec3f>  &data, float w_value) -> std::vector<std::array<buffer::packed_2_10_10_10, 1>>
+        {
+            auto packed = std::vector<std::array<buffer::packed_2_10_10_10, 1>>(data.size());
+            for(auto i = std::size_t{0}; i < data.size(); ++i) {
+                packed[i][0] = pack_2_10_10_10( utils::vec4f{ data[i][0], data[i][1], data[i][2], w_value } );
+            }
+            return packed;
+        }
+
+        auto pack_2_10_10_10(const std::vector<utils::vec4f>  &data) -> std::vector<std::array<buffer::packed_2_10_10_10, 1>>
+        {
+            auto packed = std::vector<std::array<buffer::packed_2_10_10_10, 1>>(data.size());
+            for(auto i = std::size_t{0}; i < data.size(); ++i) {
+                packed[i][0] = pack_2_10_10_10( data[i] );
+            }
+            return packed;
+        }
+    } // namespace vertex_format
+} // namespace nitros::glcore
@@ -1,8 +1,12 @@
 
 
 #include <glcore/vertexarray.hpp>
+#include <glcore/indirect_buffer.hpp>
+#include "glcore/state_cache.hpp"
 #include "platform/gl.hpp"
 #include <exception>
+#include <stdexcept>
+#include <algorithm>
 
 namespace nitros::glcore
 {
@@ -17,6 +21,8 @@ namespace nitros::glcore
             case VertexArray::draw_mode::line_strip  : return GL_LINE_STRIP;
             case VertexArray::draw_mode::points   : return GL_POINTS;
             case VertexArray::draw_mode::triangles   : return GL_TRIANGLES;
+            case VertexArray::draw_mode::triangle_strip  : return GL_TRIANGLE_STRIP;
+            case VertexArray::draw_mode::triangle_fan    : return GL_TRIANGLE_FAN;
             
             #if defined(OPENGL_CORE) || OPENGL_ES >= 30200
             case VertexArray::draw_mode::patches     : return GL_PATCHES;
@@ -34,16 +40,60 @@ namespace nitros::glcore
                     break;
             case Buffer::value_type::UINT  : return GL_UNSIGNED_INT;
                     break;
+            case Buffer::value_type::INT   : return GL_INT;
+                    break;
+            case Buffer::value_type::USHORT : return GL_UNSIGNED_SHORT;
+                    break;
+            case Buffer::value_type::SHORT : return GL_SHORT;
+                    break;
+            case Buffer::value_type::UBYTE : return GL_UNSIGNED_BYTE;
+                    break;
+            case Buffer::value_type::BYTE  : return GL_BYTE;
+                    break;
+            case Buffer::value_type::HALF  : return GL_HALF_FLOAT;
+                    break;
+            case Buffer::value_type::INT_2_10_10_10 : return GL_INT_2_10_10_10_REV;
+                    break;
             default:
                 return GL_FLOAT;
             }
         }
+
+        inline auto get_index_type(Buffer::value_type  type) {
+            switch (type)
+            {
+            case Buffer::value_type::UINT   : return GL_UNSIGNED_INT;
+            case Buffer::value_type::USHORT : return GL_UNSIGNED_SHORT;
+            case Buffer::value_type::UBYTE  : return GL_UNSIGNED_BYTE;
+            default:
+                throw std::invalid_argument{"Index Buffer must be UINT, USHORT or UBYTE"};
+            }
+        }
+
+        inline auto get_index_size(Buffer::value_type  type) -> std::size_t {
+            switch (type)
+            {
+            case Buffer::value_type::UINT   : return sizeof(std::uint32_t);
+            case Buffer::value_type::USHORT : return sizeof(std::uint16_t);
+            case Buffer::value_type::UBYTE  : return sizeof(std::uint8_t);
+            default:
+                throw std::invalid_argument{"Index Buffer must be UINT, USHORT or UBYTE"};
+            }
+        }
     } // namespace name
     
 
     VertexArray::VertexArray()
         :_draw_mode{draw_mode::triangles}
+        ,_primitive_restart{false}
         ,_vertices_per_primtive{}
+        ,_vertex_count{0}
+        ,_bindings{}
+        ,_divisors{}
+        ,_index_heap{}
+        ,_index_handle{}
+        ,_index_type{Buffer::value_type::UINT}
+        ,_specification{ {}, {nullptr, 0, 0, 0, Buffer::value_type::FLOAT, false}, 0, {}, {}, true }
     {
     #if OPENGL_CORE >= 40500
         glCreateVertexArrays(1, &_id);
@@ -54,64 +104,484 @@ namespace nitros::glcore
 
     VertexArray::~VertexArray()
     {
+        StateCache::get_instance().forget_vertex_array(_id);
         glDeleteVertexArrays(1, &_id);
     }
 
+    namespace
+    {
+        void attrib_format([[maybe_unused]] std::uint32_t  vao, [[maybe_unused]] const vertex::AttributeFormat  &attribute)
+        {
+        #if OPENGL_CORE >= 40500
+            if(attribute.integer)
+                glVertexArrayAttribIFormat(vao, attribute.location, attribute.components, get_v(attribute.type), gsl::narrow_cast<GLuint>(attribute.offset));
+            else
+                glVertexArrayAttribFormat(vao, attribute.location, attribute.components, get_v(attribute.type), attribute.normalized ? GL_TRUE : GL_FALSE, gsl::narrow_cast<GLuint>(attribute.offset));
+        #elif defined(OPENGL_CORE)
+            if(attribute.integer)
+                glVertexAttribIFormat(attribute.location, attribute.components, get_v(attribute.type), gsl::narrow_cast<GLuint>(attribute.offset));
+            else
+                glVertexAttribFormat(attribute.location, attribute.components, get_v(attribute.type), attribute.normalized ? GL_TRUE : GL_FALSE, gsl::narrow_cast<GLuint>(attribute.offset));
+        #endif
+        }
+
+        auto legacy_format(std::uint32_t  location, const Buffer  &buffer) -> vertex::AttributeFormat
+        {
+            return {
+                location,
+                gsl::narrow_cast<std::uint32_t>( buffer.vec_length() ),
+                buffer.get_value_type(),
+                buffer.is_normalized(),
+                buffer.is_integer_attribute(),
+                0
+            };
+        }
+    }
+
     void VertexArray::bind() const
     {
-        glBindVertexArray(_id);
-        for(auto &[index, buffer] : buffers)
+        bind_vertex_array();
+
+    #if defined(OPENGL_CORE) || OPENGL_ES >= 30200
+        if(_draw_mode == draw_mode::patches) 
+        {
+            glPatchParameteri(GL_PATCH_VERTICES, _vertices_per_primtive);
+        }
+    #endif
+    }
+
+    void VertexArray::bind_vertex_array() const
+    {
+        if(specification_changed()) {
+            specify();
+        }
+        StateCache::get_instance().bind_vertex_array(_id);
+    }
+
+    auto VertexArray::buffer_state(const std::shared_ptr<Buffer>  &buffer) -> BufferState
+    {
+        if(!buffer) {
+            return { nullptr, 0, 0, 0, Buffer::value_type::FLOAT, false };
+        }
+        return { buffer.get(), buffer->get_id(), buffer->row_stride(), buffer->vec_length(), buffer->get_value_type(), buffer->is_normalized() };
+    }
+
+    auto VertexArray::same_state(const BufferState  &state, const std::shared_ptr<Buffer>  &buffer) -> bool
+    {
+        const auto current = buffer_state(buffer);
+        return state.buffer == current.buffer && state.id == current.id && state.stride == current.stride
+            && state.components == current.components && state.type == current.type && state.normalized == current.normalized;
+    }
+
+    auto VertexArray::specification_changed() const -> bool
+    {
+        if(_specification.dirty || _specification.buffers.size() != buffers.size()) {
+            return true;
+        }
+
+        if(!same_state(_specification.index, index) || _specification.index_heap != (index || !_index_heap ? 0 : _index_heap->get_id())) {
+            return true;
+        }
+        for(auto &[location, buffer] : buffers)
+        {
+            auto it = _specification.buffers.find(location);
+            if(it == _specification.buffers.end() || !same_state(it->second, buffer)) {
+                return true;
+            }
+        }
+        //write_data may replace the buffer object of a Buffer, see ObjectPool
+        for(auto &[binding_index, binding] : _bindings)
+        {
+            auto it = _specification.binding_ids.find(binding_index);
+            if(it == _specification.binding_ids.end() || it->second != binding.buffer->get_id()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void VertexArray::specify() const
+    {
+        for(auto &[binding_index, binding] : _bindings) {
+            if(buffers.count(binding_index)) {
+                throw std::logic_error{"Vertex Binding index is used by an attribute Buffer"};
+            }
+        }
+        if(index && index->get_buffer_type() != Buffer::buffer_type::ELEMENT_BUFFER) {
+            throw std::logic_error{"Index Buffer needs the ELEMENT_BUFFER role"};
+        }
+
+        auto enabled = std::vector<std::uint32_t>{};
+
+    #if OPENGL_CORE >= 40500
+        for(auto &[location, buffer] : buffers)
+        {
+            glVertexArrayVertexBuffer(_id, location, buffer->get_id(), 0, gsl::narrow_cast<GLsizei>( buffer->row_stride() ));
+            glVertexArrayBindingDivisor(_id, location, get_divisor(location));
+            attrib_format(_id, legacy_format(location, *buffer));
+            glVertexArrayAttribBinding(_id, location, location);
+            enabled.push_back(location);
+        }
+        for(auto &[binding_index, binding] : _bindings)
+        {
+            glVertexArrayVertexBuffer(_id, binding_index, binding.buffer->get_id(), gsl::narrow_cast<GLintptr>( binding.offset ), gsl::narrow_cast<GLsizei>( binding.stride ));
+            glVertexArrayBindingDivisor(_id, binding_index, binding.divisor);
+            for(auto &attribute : binding.attributes)
+            {
+                attrib_format(_id, attribute);
+                glVertexArrayAttribBinding(_id, attribute.location, binding_index);
+                enabled.push_back(attribute.location);
+            }
+        }
+        for(auto location : _specification.enabled_locations) {
+            if(std::find(enabled.begin(), enabled.end(), location) == enabled.end())
+                glDisableVertexArrayAttrib(_id, location);
+        }
+        for(auto location : enabled) {
+            glEnableVertexArrayAttrib(_id, location);
+        }
+        glVertexArrayElementBuffer(_id, element_id());
+
+    #elif defined(OPENGL_CORE)
+        StateCache::get_instance().bind_vertex_array(_id);
+        for(auto &[location, buffer] : buffers)
+        {
+            glBindVertexBuffer(location, buffer->get_id(), 0, gsl::narrow_cast<GLsizei>( buffer->row_stride() ));
+            glVertexBindingDivisor(location, get_divisor(location));
+            attrib_format(_id, legacy_format(location, *buffer));
+            glVertexAttribBinding(location, location);
+            enabled.push_back(location);
+        }
+        for(auto &[binding_index, binding] : _bindings)
+        {
+            glBindVertexBuffer(binding_index, binding.buffer->get_id(), gsl::narrow_cast<GLintptr>( binding.offset ), gsl::narrow_cast<GLsizei>( binding.stride ));
+            glVertexBindingDivisor(binding_index, binding.divisor);
+            for(auto &attribute : binding.attributes)
+            {
+                attrib_format(_id, attribute);
+                glVertexAttribBinding(attribute.location, binding_index);
+                enabled.push_back(attribute.location);
+            }
+        }
+        for(auto location : _specification.enabled_locations) {
+            if(std::find(enabled.begin(), enabled.end(), location) == enabled.end())
+                glDisableVertexAttribArray(location);
+        }
+        for(auto location : enabled) {
+            glEnableVertexAttribArray(location);
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_id());
+
+    #else
+        StateCache::get_instance().bind_vertex_array(_id);
+        auto attrib_pointer = [](const vertex::AttributeFormat  &attribute, std::size_t  stride, std::size_t  offset) {
+            const auto pointer = reinterpret_cast<const void*>( offset + attribute.offset );
+            if(attribute.integer)
+                glVertexAttribIPointer(attribute.location, attribute.components, get_v(attribute.type), gsl::narrow_cast<GLsizei>(stride), pointer);
+            else
+                glVertexAttribPointer(attribute.location, attribute.components, get_v(attribute.type), attribute.normalized ? GL_TRUE : GL_FALSE, gsl::narrow_cast<GLsizei>(stride), pointer);
+        };
+
+        for(auto &[location, buffer] : buffers)
         {
             buffer->bind(Buffer::buffer_type::ARRAY_BUFFER);
-            glVertexAttribPointer(index, buffer->vec_length(), GL_FLOAT , GL_FALSE, 0, nullptr);
-            
-        #if defined(OPENGL_CORE) || OPENGL_ES >= 30200
-            if(_draw_mode == draw_mode::patches) 
+            attrib_pointer(legacy_format(location, *buffer), 0, 0);
+            glVertexAttribDivisor(location, get_divisor(location));
+            enabled.push_back(location);
+        }
+        for(auto &[binding_index, binding] : _bindings)
+        {
+            glBindBuffer(GL_ARRAY_BUFFER, binding.buffer->get_id());
+            for(auto &attribute : binding.attributes)
             {
-                glPatchParameteri(GL_PATCH_VERTICES, _vertices_per_primtive);
+                attrib_pointer(attribute, binding.stride, binding.offset);
+                glVertexAttribDivisor(attribute.location, binding.divisor);
+                enabled.push_back(attribute.location);
             }
-        #endif
+        }
+        for(auto location : _specification.enabled_locations) {
+            if(std::find(enabled.begin(), enabled.end(), location) == enabled.end())
+                glDisableVertexAttribArray(location);
+        }
+        for(auto location : enabled) {
+            glEnableVertexAttribArray(location);
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, element_id());
+    #endif
 
-            glEnableVertexAttribArray(index);
+        _specification.buffers.clear();
+        for(auto &[location, buffer] : buffers) {
+            _specification.buffers[location] = buffer_state(buffer);
         }
-        if(index)
-            index->bind(Buffer::buffer_type::ELEMENT_BUFFER);
-        glBindVertexArray(0);
+        _specification.index = buffer_state(index);
+        _specification.index_heap = index || !_index_heap ? 0 : _index_heap->get_id();
+        _specification.binding_ids.clear();
+        for(auto &[binding_index, binding] : _bindings) {
+            _specification.binding_ids[binding_index] = binding.buffer->get_id();
+        }
+        _specification.enabled_locations = std::move(enabled);
+        _specification.dirty = false;
     }
 
     void VertexArray::draw() const
     {
-        glBindVertexArray(_id);
-        if(index){
-            glDrawElements(get_gl(_draw_mode) , index->get_elements_count(), GL_UNSIGNED_INT, 0);
+        bind_vertex_array();
+        if(auto elements = element_source())
+            draw_elements(*elements, 0, elements->count, 1, 0);
+        else
+            draw_vertices(0, vertex_count(), 1, 0);
+    }
+
+    void VertexArray::draw_arrays(std::uint32_t  first, std::uint32_t  count) const
+    {
+        bind_vertex_array();
+        draw_vertices(first, count, 1, 0);
+    }
+
+    void VertexArray::draw_index_count(std::uint32_t  index_offset, std::uint32_t  index_count) const
+    {
+        bind_vertex_array();
+        if(auto elements = element_source()) {
+            draw_elements(*elements, index_offset, index_count, 1, 0);
         }
+    }
+
+    void VertexArray::draw_instanced(std::uint32_t  instance_count, std::uint32_t  base_instance) const
+    {
+        bind_vertex_array();
+        if(auto elements = element_source())
+            draw_elements(*elements, 0, elements->count, instance_count, base_instance);
         else
-            glDrawArrays( get_gl(_draw_mode), 0, buffers.at(0)->get_elements_count()/buffers.at(0)->vec_length());
+            draw_vertices(0, vertex_count(), instance_count, base_instance);
+    }
+
+    void VertexArray::draw_arrays_instanced(std::uint32_t  first, std::uint32_t  count, std::uint32_t  instance_count, std::uint32_t  base_instance) const
+    {
+        bind_vertex_array();
+        draw_vertices(first, count, instance_count, base_instance);
+    }
+
+    void VertexArray::draw_index_count_instanced(std::uint32_t  index_offset, std::uint32_t  index_count, std::uint32_t  instance_count, std::uint32_t  base_instance) const
+    {
+        bind_vertex_array();
+        if(auto elements = element_source()) {
+            draw_elements(*elements, index_offset, index_count, instance_count, base_instance);
+        }
+    }
+
+    void VertexArray::draw_range(const vertex::MeshRange  &range) const
+    {
+        draw_range_instanced(range, 1, 0);
+    }
+
+    void VertexArray::draw_range_instanced(const vertex::MeshRange  &range, std::uint32_t  instance_count, std::uint32_t  base_instance) const
+    {
+        const auto elements = element_source();
+        if(!elements) {
+            throw std::logic_error{"Mesh Range draws need an index Buffer"};
+        }
+        bind_vertex_array();
+        draw_elements(*elements, range.first_index, range.count, instance_count, base_instance, range.base_vertex);
+    }
+
+    void VertexArray::draw_ranges(gsl::span<const vertex::MeshRange>  ranges) const
+    {
+        const auto elements = element_source();
+        if(!elements) {
+            throw std::logic_error{"Mesh Range draws need an index Buffer"};
+        }
+        if(ranges.empty()) {
+            return;
+        }
+        bind_vertex_array();
 
     #if defined(OPENGL_CORE)
-        glBindVertexArray(0);
+        const auto element_stride = get_index_size(elements->type);
+
+        auto counts       = std::vector<GLsizei>{};
+        auto offsets      = std::vector<const void*>{};
+        auto base_vertices = std::vector<GLint>{};
+        counts.reserve(ranges.size());
+        offsets.reserve(ranges.size());
+        base_vertices.reserve(ranges.size());
+
+        for(auto &range : ranges)
+        {
+            counts.push_back( gsl::narrow_cast<GLsizei>( clamp_index_count(*elements, range.first_index, range.count) ) );
+            offsets.push_back( reinterpret_cast<const void*>( elements->offset + element_stride * range.first_index ) );
+            base_vertices.push_back( range.base_vertex );
+        }
+
+        apply_primitive_restart();
+        glMultiDrawElementsBaseVertex(get_gl(_draw_mode), counts.data(), get_index_type(elements->type), offsets.data(), gsl::narrow_cast<GLsizei>(ranges.size()), base_vertices.data());
+    #else
+        for(auto &range : ranges) {
+            draw_elements(*elements, range.first_index, range.count, 1, 0, range.base_vertex);
+        }
     #endif
     }
 
-    void VertexArray::draw_index_count(std::uint32_t  index_offset, std::uint32_t  index_count) const
+    void VertexArray::draw_indirect(const IndirectCommandBuffer  &commands, std::size_t  first, std::size_t  count) const
+    {
+        const auto available  = commands.size() - std::min(commands.size(), first);
+        const auto draw_count = std::min(available, count);
+        const auto elements   = commands.get_command_type() == IndirectCommandBuffer::command_type::elements;
+        auto       source     = element_source();
+
+        if(elements && !source) {
+            throw std::logic_error{"Draw Elements Commands need an index Buffer"};
+        }
+        if(draw_count == 0) {
+            return;
+        }
+
+        bind_vertex_array();
+    #if defined(OPENGL_CORE)
+        commands.bind();
+        const auto offset = reinterpret_cast<const void*>( first * commands.command_stride() );
+        if(elements) {
+            apply_primitive_restart();
+            glMultiDrawElementsIndirect(get_gl(_draw_mode), get_index_type(source->type), offset, gsl::narrow_cast<GLsizei>(draw_count), 0);
+        }
+        else
+            glMultiDrawArraysIndirect(get_gl(_draw_mode), offset, gsl::narrow_cast<GLsizei>(draw_count), 0);
+    #else
+        //No indirect draws and no base vertex on OpenGL ES 3.0, the client copy is drawn command by command
+        const auto first_ = gsl::narrow_cast<std::ptrdiff_t>(first);
+        const auto count_ = gsl::narrow_cast<std::ptrdiff_t>(draw_count);
+        if(elements)
+        {
+            //first_index counts from the start of the element buffer object, as on OpenGL core
+            source->count += source->offset / get_index_size(source->type);
+            source->offset = 0;
+            for(auto &command : commands.elements_commands().subspan(first_, count_)) {
+                draw_elements(*source, command.first_index, command.count, command.instance_count, command.base_instance, command.base_vertex);
+            }
+        }
+        else
+        {
+            for(auto &command : commands.arrays_commands().subspan(first_, count_)) {
+                draw_vertices(command.first, command.count, command.instance_count, command.base_instance);
+            }
+        }
+    #endif
+    }
+
+    auto VertexArray::vertex_count() const -> std::uint32_t
     {
-        glBindVertexArray(_id);
-        if(index)
+        //Per instance buffers don't count the vertices
+        for(auto &[location, buffer] : buffers) {
+            if(get_divisor(location) == 0)
+                return gsl::narrow_cast<std::uint32_t>( buffer->get_elements_count()/buffer->vec_length() );
+        }
+        return _vertex_count;
+    }
+
+    auto VertexArray::element_source() const -> std::optional<ElementSource>
+    {
+        if(index) {
+            return ElementSource{ index->get_id(), 0, index->get_elements_count(), index->get_value_type() };
+        }
+        if(_index_heap)
         {
-            auto row_stride   = index->row_stride();
-            auto num_of_comps = index->vec_length();
+            //Handles move on defragment, the range is looked up on every draw
+            const auto range = _index_heap->get_range(_index_handle);
+            return ElementSource{ _index_heap->get_id(), range.offset, range.size / get_index_size(_index_type), _index_type };
+        }
+        return std::nullopt;
+    }
 
-            auto element_stride = row_stride / num_of_comps;
-            auto ind_count = std::min( index->get_elements_count(), static_cast<std::size_t>(index_count) );
-            
-            glDrawElements(get_gl(_draw_mode) , index_count, GL_UNSIGNED_INT, reinterpret_cast<void*>( element_stride * index_offset ) );
+    auto VertexArray::element_id() const -> std::uint32_t
+    {
+        if(index) {
+            return index->get_id();
         }
+        return _index_heap ? _index_heap->get_id() : 0;
+    }
+
+    auto VertexArray::clamp_index_count(const ElementSource  &elements, std::uint32_t  index_offset, std::size_t  index_count) -> std::size_t
+    {
+        auto available = elements.count - std::min( elements.count, static_cast<std::size_t>(index_offset) );
+        return std::min( available, index_count );
+    }
 
+    void VertexArray::draw_elements(const ElementSource  &elements, std::uint32_t  index_offset, std::size_t  index_count, std::uint32_t  instance_count, std::uint32_t  base_instance, std::int32_t  base_vertex) const
+    {
+        auto element_stride = get_index_size(elements.type);
+        auto ind_count = gsl::narrow_cast<GLsizei>( clamp_index_count(elements, index_offset, index_count) );
+        auto offset    = reinterpret_cast<void*>( elements.offset + element_stride * index_offset );
+
+        apply_primitive_restart();
+        if(instance_count == 1 && base_instance == 0 && base_vertex == 0) {
+            glDrawElements(get_gl(_draw_mode), ind_count, get_index_type(elements.type), offset);
+            return;
+        }
+    #if defined(OPENGL_CORE)
+        if(instance_count == 1 && base_instance == 0)
+            glDrawElementsBaseVertex(get_gl(_draw_mode), ind_count, get_index_type(elements.type), offset, base_vertex);
+        else
+            glDrawElementsInstancedBaseVertexBaseInstance(get_gl(_draw_mode), ind_count, get_index_type(elements.type), offset, gsl::narrow_cast<GLsizei>(instance_count), base_vertex, base_instance);
+    #else
+        if(base_vertex != 0) {
+            throw std::invalid_argument{"Base Vertex is not supported by OpenGL ES"};
+        }
+        if(base_instance != 0) {
+            throw std::invalid_argument{"Base Instance is not supported by OpenGL ES"};
+        }
+        glDrawElementsInstanced(get_gl(_draw_mode), ind_count, get_index_type(elements.type), offset, gsl::narrow_cast<GLsizei>(instance_count));
+    #endif
+    }
+
+    void VertexArray::draw_vertices(std::uint32_t  first, std::uint32_t  count, std::uint32_t  instance_count, std::uint32_t  base_instance) const
+    {
+        if(instance_count == 1 && base_instance == 0) {
+            glDrawArrays( get_gl(_draw_mode), gsl::narrow_cast<GLint>(first), gsl::narrow_cast<GLsizei>(count) );
+            return;
+        }
     #if defined(OPENGL_CORE)
-        glBindVertexArray(0);
+        glDrawArraysInstancedBaseInstance( get_gl(_draw_mode), gsl::narrow_cast<GLint>(first), gsl::narrow_cast<GLsizei>(count), gsl::narrow_cast<GLsizei>(instance_count), base_instance );
+    #else
+        if(base_instance != 0) {
+            throw std::invalid_argument{"Base Instance is not supported by OpenGL ES"};
+        }
+        glDrawArraysInstanced( get_gl(_draw_mode), gsl::narrow_cast<GLint>(first), gsl::narrow_cast<GLsizei>(count), gsl::narrow_cast<GLsizei>(instance_count) );
     #endif
     }
 
+    void VertexArray::set_index_heap(std::shared_ptr<const BufferHeap>  heap, BufferHeap::Handle  handle, Buffer::value_type  type)
+    {
+        if(!heap) {
+            throw std::invalid_argument{"Index Heap is null"};
+        }
+        //Both throw std::invalid_argument, for a non index type and for a freed handle
+        static_cast<void>( get_index_size(type) );
+        static_cast<void>( heap->get_range(handle) );
+
+        _index_heap   = std::move(heap);
+        _index_handle = handle;
+        _index_type   = type;
+    }
+
+    void VertexArray::reset_index_heap() noexcept
+    {
+        _index_heap.reset();
+    }
+
+    void VertexArray::set_divisor(std::uint32_t  location, std::uint32_t  divisor)
+    {
+        if(divisor == 0)
+            _divisors.erase(location);
+        else
+            _divisors[location] = divisor;
+        _specification.dirty = true;
+    }
+
+    auto VertexArray::get_divisor(std::uint32_t  location) const -> std::uint32_t
+    {
+        auto it = _divisors.find(location);
+        return it != _divisors.end() ? it->second : 0;
+    }
+
     void VertexArray::set_draw_mode(draw_mode mode, const std::uint32_t  &patch_vertices) {
         if(mode == draw_mode::patches){
             if(patch_vertices > 0)
@@ -125,7 +595,10 @@ namespace nitros::glcore
         else if(mode == draw_mode::line || mode == draw_mode::line_loop){
             _vertices_per_primtive = 2;
         }
-        else if(mode == draw_mode::triangles){
+        else if(mode == draw_mode::line_strip){
+            _vertices_per_primtive = 2;
+        }
+        else if(mode == draw_mode::triangles || mode == draw_mode::triangle_strip || mode == draw_mode::triangle_fan){
             _vertices_per_primtive = 3;
         }
         else if(mode == draw_mode::points){
@@ -134,4 +607,52 @@ namespace nitros::glcore
         _draw_mode = mode;
     }
 
-}
\ No newline at end of file
+    void VertexArray::set_primitive_restart(bool enable) noexcept {
+        _primitive_restart = enable;
+    }
+
+    void VertexArray::apply_primitive_restart() const {
+    #if defined(OPENGL_CORE)
+        StateCache::get_instance().set_capability(GL_PRIMITIVE_RESTART_FIXED_INDEX, _primitive_restart);
+    #endif
+    }
+
+    void VertexArray::set_binding(std::uint32_t  binding, vertex::Binding  &&vertex_binding)
+    {
+        if(!vertex_binding.buffer) {
+            throw std::invalid_argument{"Vertex Binding needs a Buffer"};
+        }
+        _bindings[binding] = std::move(vertex_binding);
+        _specification.dirty = true;
+    }
+
+    void VertexArray::rebind(std::uint32_t  binding, std::shared_ptr<const GLobj>  &&buffer, std::size_t  offset)
+    {
+        auto it = _bindings.find(binding);
+        if(it == _bindings.end()) {
+            throw std::invalid_argument{"Vertex Binding is not set"};
+        }
+        if(!buffer) {
+            throw std::invalid_argument{"Vertex Binding needs a Buffer"};
+        }
+
+        auto &vertex_binding = it->second;
+        vertex_binding.buffer = std::move(buffer);
+        vertex_binding.offset = offset;
+
+        if(_specification.dirty) {
+            return;
+        }
+        _specification.binding_ids[binding] = vertex_binding.buffer->get_id();
+
+    #if OPENGL_CORE >= 40500
+        glVertexArrayVertexBuffer(_id, binding, vertex_binding.buffer->get_id(), gsl::narrow_cast<GLintptr>( offset ), gsl::narrow_cast<GLsizei>( vertex_binding.stride ));
+    #elif defined(OPENGL_CORE)
+        StateCache::get_instance().bind_vertex_array(_id);
+        glBindVertexBuffer(binding, vertex_binding.buffer->get_id(), gsl::narrow_cast<GLintptr>( offset ), gsl::narrow_cast<GLsizei>( vertex_binding.stride ));
+    #else
+        _specification.dirty = true;
+    #endif
+    }
+
+}